@@ -0,0 +1,154 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares the number of coverage counters and counter updates per execution
+// of the example fuzz targets with and without counter pruning
+// (`--prune_counters`). Only the coverage instrumentation is applied, and the
+// counters of each module are replaced by a proxy counting the writes to them.
+// Both modes run the fuzz targets on the same pseudo-random inputs. The
+// examples have to be installed first, see README.md.
+//
+// Usage: node bench.js [executions]
+
+const fs = require("fs");
+const Module = require("module");
+const path = require("path");
+
+const { Instrumentor } = require("@jazzer.js/instrumentor");
+const {
+	codeCoverage,
+} = require("@jazzer.js/instrumentor/dist/plugins/codeCoverage");
+const {
+	ZeroEdgeIdStrategy,
+} = require("@jazzer.js/instrumentor/dist/edgeIdStrategy");
+
+const executions = parseInt(process.argv[2] ?? "10000", 10);
+
+const examples = path.join(__dirname, "..", "..", "examples");
+// Instrumented modules as in the `fuzz` scripts of the examples.
+const targets = [
+	{ example: "jpeg", fuzzTarget: "fuzz.js", includes: ["jpeg-js"] },
+	{ example: "xml", fuzzTarget: "fuzz.js", includes: ["xml"] },
+	{
+		example: "spectral",
+		fuzzTarget: "spectral-example.js",
+		includes: ["spectral"],
+	},
+];
+
+let counters = 0;
+let writes = 0;
+globalThis.Fuzzer = {
+	coverageTracker: {
+		counterRange: (firstEdgeId, edgeCount) => {
+			counters += edgeCount;
+			return new Proxy(new Uint8Array(edgeCount), {
+				set(target, key, value) {
+					writes++;
+					target[key] = value;
+					return true;
+				},
+			});
+		},
+	},
+};
+
+const instrumentor = new Instrumentor();
+const loadJs = Module._extensions[".js"];
+
+function load(target, pruneCounters) {
+	const dir = path.join(examples, target.example);
+	for (const key of Object.keys(require.cache)) {
+		if (key.startsWith(dir)) {
+			delete require.cache[key];
+		}
+	}
+	Module._extensions[".js"] = (module, filename) => {
+		if (!target.includes.some((include) => filename.includes(include))) {
+			return loadJs(module, filename);
+		}
+		const code = fs.readFileSync(filename, "utf8");
+		const result = instrumentor.transform(filename, code, [
+			codeCoverage(new ZeroEdgeIdStrategy(), pruneCounters),
+		]);
+		module._compile(result?.code ?? code, filename);
+	};
+	try {
+		return require(path.join(dir, target.fuzzTarget)).fuzz;
+	} finally {
+		Module._extensions[".js"] = loadJs;
+	}
+}
+
+// Deterministic inputs, so that both modes execute the same code.
+function* inputs(seed) {
+	let state = seed;
+	const next = () => {
+		state = (state * 1103515245 + 12345) >>> 0;
+		return state >>> 16;
+	};
+	for (let i = 0; i < executions; i++) {
+		const input = Buffer.alloc(next() % 512);
+		for (let j = 0; j < input.length; j++) {
+			input[j] = next() & 0xff;
+		}
+		yield input;
+	}
+}
+
+async function bench(target, pruneCounters) {
+	counters = 0;
+	const fuzz = load(target, pruneCounters);
+	writes = 0;
+	const start = process.hrtime.bigint();
+	for (const input of inputs(1)) {
+		try {
+			await fuzz(input);
+		} catch {
+			// Findings don't matter here.
+		}
+	}
+	const time = Number(process.hrtime.bigint() - start) / 1e6;
+	return {
+		example: target.example,
+		pruning: pruneCounters ? "on" : "off",
+		counters,
+		"writes/exec": Math.round(writes / executions),
+		"time (ms)": Math.round(time),
+	};
+}
+
+async function main() {
+	const results = [];
+	for (const target of targets) {
+		if (!fs.existsSync(path.join(examples, target.example, "node_modules"))) {
+			console.error(`Skipping ${target.example}, it is not installed.`);
+			continue;
+		}
+		for (const pruneCounters of [false, true]) {
+			results.push(await bench(target, pruneCounters));
+		}
+	}
+
+	if (process.env.JAZZER_BENCH_JSON) {
+		console.log(JSON.stringify(results, null, 2));
+	} else {
+		console.log(`${executions} executions per example`);
+		console.table(results);
+	}
+}
+
+main();
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Fuzzes the examples for a fixed number of runs with a fixed seed and reports
+// throughput, peak RSS, startup time and covered edges, so that releases can
+// be compared. A trivial fuzz target in sync and async mode measures the cost
+// of a fuzzer iteration itself. The examples have to be installed first, see
+// README.md, examples that are not installed are skipped.
+//
+// Usage: node bench.js [runs]
+
+const { spawn } = require("child_process");
+const fs = require("fs");
+const path = require("path");
+
+const runs = parseInt(process.argv[2] ?? "20000", 10);
+
+const cli = require.resolve("@jazzer.js/core/dist/cli.js");
+const examples = path.join(__dirname, "..", "..", "examples");
+const fuzzerOptions = [`-runs=${runs}`, "-seed=1", "-print_final_stats=1"];
+
+// Arguments as in the `fuzz` scripts of the examples.
+const targets = [
+	{ name: "callback (sync)", dir: __dirname, args: ["fuzz", "--sync"] },
+	{ name: "callback (async)", dir: __dirname, args: ["fuzz"] },
+	{
+		name: "jpeg",
+		dir: path.join(examples, "jpeg"),
+		args: ["fuzz", "-i", "jpeg-js", "--sync"],
+	},
+	{
+		name: "js-yaml",
+		dir: path.join(examples, "js-yaml"),
+		args: ["dist/fuzz", "-i", "js-yaml"],
+		fuzzerOptions: ["-use_value_profile=1"],
+	},
+	{ name: "xml", dir: path.join(examples, "xml"), args: ["fuzz", "-i", "xml"] },
+	{
+		// A Jest fuzz test of an ES module.
+		name: "protobufjs",
+		dir: path.join(examples, "protobufjs"),
+		jest: true,
+	},
+];
+
+function command(target) {
+	const options = [...fuzzerOptions, ...(target.fuzzerOptions ?? [])];
+	if (!target.jest) {
+		return {
+			args: [cli, ...target.args, "--", ...options],
+			env: process.env,
+		};
+	}
+	return {
+		args: [
+			"--experimental-vm-modules",
+			require.resolve("jest/bin/jest", { paths: [target.dir] }),
+		],
+		env: {
+			...process.env,
+			JAZZER_FUZZ: "1",
+			JAZZER_FUZZER_OPTIONS: JSON.stringify(options),
+		},
+	};
+}
+
+function bench(target) {
+	const { args, env } = command(target);
+	return new Promise((resolve) => {
+		const start = process.hrtime.bigint();
+		let startup;
+		let stderr = "";
+		const proc = spawn(process.execPath, args, { cwd: target.dir, env });
+		proc.stdout.resume();
+		proc.stderr.setEncoding("utf8");
+		proc.stderr.on("data", (data) => {
+			stderr += data;
+			// libFuzzer is done with the initial corpus and starts mutating.
+			if (startup === undefined && stderr.includes("INITED")) {
+				startup = Number(process.hrtime.bigint() - start) / 1e6;
+			}
+		});
+		proc.on("close", (code, signal) => {
+			// A finding exits with an error as well, but still reports its final
+			// stats. Without them, the target failed to run and its row must not
+			// pass for a result.
+			if (code !== 0 && !stderr.includes("stat::")) {
+				console.error(`${target.name} failed:\n${stderr.slice(-2000)}`);
+				process.exitCode = 1;
+				resolve({
+					target: target.name,
+					failed: signal ?? `exit code ${code}`,
+				});
+				return;
+			}
+			const stat = (name) =>
+				parseInt(stderr.match(new RegExp(`stat::${name}:\\s+(\\d+)`))?.[1]);
+			const coverage = [...stderr.matchAll(/\bcov: (\d+)/g)];
+			resolve({
+				target: target.name,
+				"exec/s": stat("average_exec_per_sec"),
+				"peak RSS (MB)": stat("peak_rss_mb"),
+				"startup (ms)": Math.round(startup),
+				edges: parseInt(coverage[coverage.length - 1]?.[1]),
+			});
+		});
+	});
+}
+
+async function main() {
+	const results = [];
+	for (const target of targets) {
+		if (
+			target.dir !== __dirname &&
+			!fs.existsSync(path.join(target.dir, "node_modules"))
+		) {
+			console.error(`Skipping ${target.name}, it is not installed.`);
+			continue;
+		}
+		results.push(await bench(target));
+	}
+
+	if (process.env.JAZZER_BENCH_JSON) {
+		console.log(JSON.stringify(results, null, 2));
+	} else {
+		console.log(`${runs} runs per target`);
+		console.table(results);
+	}
+}
+
+main();
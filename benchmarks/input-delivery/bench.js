@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares copied and zero-copy input delivery (`--zero_copy_input`) in sync
+// and async mode. The fuzzer is seeded with large inputs, so that the cost of
+// handing the input to the fuzz target dominates the trivial fuzz target.
+// Throughput is taken from libFuzzer's final stats, garbage collection counts
+// and pauses from V8's `--trace-gc` output.
+//
+// Usage: node bench.js [runs] [input size in bytes]
+
+const { spawnSync } = require("child_process");
+const crypto = require("crypto");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const runs = parseInt(process.argv[2] ?? "200000", 10);
+const inputSize = parseInt(process.argv[3] ?? "65536", 10);
+
+const cli = require.resolve("@jazzer.js/core/dist/cli.js");
+const corpus = fs.mkdtempSync(path.join(os.tmpdir(), "jazzer-bench-"));
+for (let i = 0; i < 16; i++) {
+	fs.writeFileSync(path.join(corpus, `seed${i}`), crypto.randomBytes(inputSize));
+}
+
+const gcPattern =
+	/ms: (Scavenge|Minor Mark-Sweep|Mark-Compact|Mark-Sweep)\b.*?MB, (?:pooled: [\d.]+ MB, )?([\d.]+) \//;
+
+function bench(sync, zeroCopyInput) {
+	const args = ["--trace-gc", cli, "fuzz", "--disable_bug_detectors=.*"];
+	if (sync) args.push("--sync");
+	if (zeroCopyInput) args.push("--zero_copy_input");
+	args.push(
+		"--",
+		corpus,
+		`-runs=${runs}`,
+		`-max_len=${inputSize}`,
+		"-len_control=0",
+		"-seed=1",
+		"-print_final_stats=1",
+	);
+	const proc = spawnSync(process.execPath, args, {
+		cwd: __dirname,
+		encoding: "utf8",
+		maxBuffer: 1 << 28,
+	});
+	const stat = (name) =>
+		parseInt(proc.stderr.match(new RegExp(`stat::${name}:\\s+(\\d+)`))?.[1]);
+
+	let gcCount = 0;
+	let gcPause = 0;
+	for (const line of proc.stdout.split("\n")) {
+		const match = line.match(gcPattern);
+		if (match) {
+			gcCount++;
+			gcPause += parseFloat(match[2]);
+		}
+	}
+	return {
+		mode: sync ? "sync" : "async",
+		input: zeroCopyInput ? "zero-copy" : "copy",
+		"exec/s": stat("average_exec_per_sec"),
+		"peak RSS (MB)": stat("peak_rss_mb"),
+		GCs: gcCount,
+		"GC pause (ms)": Math.round(gcPause),
+	};
+}
+
+const results = [];
+for (const sync of [true, false]) {
+	for (const zeroCopyInput of [false, true]) {
+		results.push(bench(sync, zeroCopyInput));
+	}
+}
+fs.rmSync(corpus, { recursive: true, force: true });
+
+if (process.env.JAZZER_BENCH_JSON) {
+	console.log(JSON.stringify(results, null, 2));
+} else {
+	console.log(`${runs} runs with ${inputSize} byte inputs`);
+	console.table(results);
+}
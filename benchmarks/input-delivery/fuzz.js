@@ -0,0 +1,29 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+let checksum = 0;
+
+/**
+ * A trivial target that only reads a few bytes of the input, so that the
+ * measured time is dominated by handing the input to the fuzz target.
+ *
+ * @param { Buffer } data
+ */
+module.exports.fuzz = function (data) {
+	if (data.length > 0) {
+		checksum ^= data[0] ^ data[data.length - 1];
+	}
+};
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmarks of the calls into the native addon on the hot paths of a
+// fuzzing run: compare tracing, the trace buffer, call site IDs, prototype
+// fingerprints and counter registration, as well as the throughput of the
+// instrumentation. Like Google Benchmark, each case runs in batches of
+// doubling size until a batch takes long enough, and then reports the median
+// of several repetitions of such a batch.
+//
+// libFuzzer is not running here, so its hooks return right away and only the
+// cost of getting from JS to them is measured. The cost per fuzzer iteration,
+// including libFuzzer, is measured by the `examples` benchmark.
+//
+// Usage: node bench.js [filter]
+
+const fs = require("fs");
+
+const { fuzzer } = require("@jazzer.js/fuzzer");
+const { addon } = require("@jazzer.js/fuzzer/dist/addon");
+const { Instrumentor } = require("@jazzer.js/instrumentor");
+const {
+	ZeroEdgeIdStrategy,
+} = require("@jazzer.js/instrumentor/dist/edgeIdStrategy");
+
+const filter = new RegExp(process.argv[2] ?? "");
+
+const MIN_BATCH_TIME_NS = 50_000_000;
+const REPETITIONS = 5;
+
+// Operands varying from call to call, so that the trace buffer does not skip
+// them as repeated events.
+const strings = Array.from({ length: 1024 }, (_, i) => `string ${i}`);
+const bytes = Buffer.alloc(64, 1);
+const otherBytes = Buffer.alloc(64, 2);
+const haystack = Buffer.alloc(4096, 3);
+const prototypes = [{}, [], "", 0, () => {}];
+const symbols = ["bench.js", ["<top-level>", "f"], Array(64 * 3).fill(1), [0]];
+
+const { tracer, coverageTracker } = fuzzer;
+
+// Each case is called with the number of the current call.
+const cases = [
+	{
+		name: "tracer.traceNumberCmp",
+		run: (i) => tracer.traceNumberCmp(i, 42, "===", i & 0xffff),
+	},
+	{
+		name: "tracer.traceNumberCmp (repeated)",
+		run: () => tracer.traceNumberCmp(1, 42, "===", 7),
+	},
+	{
+		name: "tracer.traceStrCmp",
+		run: (i) => tracer.traceStrCmp(strings[i & 1023], "x", "===", i & 0xffff),
+	},
+	{
+		name: "tracer.traceSwitch",
+		setup: () => tracer.switchCases([1, 2, 0x89504e47]),
+		run: (i, table) => tracer.traceSwitch(i, table, i & 0xffff),
+	},
+	{
+		name: "trace buffer drain (64 events)",
+		run: (i) => {
+			for (let j = 0; j < 64; j++) {
+				tracer.traceNumberCmp(i, j, "===", j);
+			}
+			addon.flushTraceBuffer();
+		},
+	},
+	{
+		name: "addon.traceIntegerCompare",
+		run: (i) => addon.traceIntegerCompare(i & 0xffff, i, 42),
+	},
+	{
+		name: "addon.traceUnequalStrings",
+		run: (i) => addon.traceUnequalStrings(i & 0xffff, strings[i & 1023], "x"),
+	},
+	{
+		name: "addon.traceStringContainment",
+		run: (i) =>
+			addon.traceStringContainment(i & 0xffff, "x", strings[i & 1023]),
+	},
+	{
+		name: "addon.traceUnequalBytes (64 bytes)",
+		run: (i) => addon.traceUnequalBytes(i & 0xffff, bytes, otherBytes),
+	},
+	{
+		name: "addon.traceBytesContainment (4 KiB)",
+		run: (i) => addon.traceBytesContainment(i & 0xffff, bytes, haystack),
+	},
+	{
+		name: "addon.tracePcIndir",
+		run: (i) => addon.tracePcIndir(i & 0xffff, i),
+	},
+	{
+		name: "addon.callSiteId",
+		run: () => addon.callSiteId(),
+	},
+	{
+		name: "addon.fingerprintPrototypes",
+		run: () => addon.fingerprintPrototypes(prototypes),
+	},
+	{
+		name: "coverageTracker.counterRange",
+		run: () => coverageTracker.counterRange(0, 64),
+	},
+	{
+		// Symbols are kept for the whole run, so limit the number of calls.
+		name: "coverageTracker.counterRange (symbols)",
+		run: () => coverageTracker.counterRange(0, 64, symbols),
+		maxCalls: 1 << 14,
+	},
+];
+
+function runBatch(testCase, state, calls) {
+	const start = process.hrtime.bigint();
+	for (let i = 0; i < calls; i++) {
+		testCase.run(i, state);
+	}
+	return Number(process.hrtime.bigint() - start);
+}
+
+function measure(testCase) {
+	const state = testCase.setup?.();
+	const maxCalls = testCase.maxCalls ?? Infinity;
+	let calls = 1;
+	while (
+		calls < maxCalls &&
+		runBatch(testCase, state, calls) < MIN_BATCH_TIME_NS
+	) {
+		calls = Math.min(calls * 2, maxCalls);
+	}
+	const samples = [];
+	for (let i = 0; i < REPETITIONS; i++) {
+		samples.push(runBatch(testCase, state, calls) / calls);
+	}
+	samples.sort((a, b) => a - b);
+	const median = samples[Math.floor(REPETITIONS / 2)];
+	return {
+		name: testCase.name,
+		calls,
+		"ns/call": round(median),
+		"min ns/call": round(samples[0]),
+		"calls/s": Math.round(1e9 / median),
+	};
+}
+
+// Instruments a large, fixed source file with the fuzzing plugins.
+function measureInstrumentation() {
+	const file = require.resolve("@babel/parser");
+	const code = fs.readFileSync(file, "utf8");
+	const instrumentor = new Instrumentor(
+		["*"],
+		[],
+		[],
+		false,
+		false,
+		new ZeroEdgeIdStrategy(),
+	);
+	instrumentor.instrument(code, file);
+	const samples = [];
+	for (let i = 0; i < REPETITIONS; i++) {
+		const start = process.hrtime.bigint();
+		instrumentor.instrument(code, file);
+		samples.push(Number(process.hrtime.bigint() - start) / 1e6);
+	}
+	samples.sort((a, b) => a - b);
+	const median = samples[Math.floor(REPETITIONS / 2)];
+	return {
+		file: "@babel/parser",
+		"size (KiB)": Math.round(code.length / 1024),
+		"ms/file": round(median),
+		"MiB/s": round(code.length / (1 << 20) / (median / 1e3)),
+	};
+}
+
+function round(value) {
+	return Math.round(value * 10) / 10;
+}
+
+const calls = cases
+	.filter((testCase) => filter.test(testCase.name))
+	.map(measure);
+const instrumentation = filter.test("instrumentation")
+	? [measureInstrumentation()]
+	: [];
+
+if (process.env.JAZZER_BENCH_JSON) {
+	console.log(JSON.stringify({ calls, instrumentation }, null, 2));
+} else {
+	console.table(calls);
+	if (instrumentation.length > 0) {
+		console.table(instrumentation);
+	}
+}
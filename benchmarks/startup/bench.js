@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares the time until libFuzzer starts mutating for the examples with edge
+// coverage, block coverage (`--block_coverage`), and block coverage with
+// rewritten comparisons (`--block_coverage_compare_hooks`). Each mode runs in
+// a fresh process, the median of several repetitions is reported. The
+// examples have to be installed first, see README.md.
+//
+// Usage: node bench.js [repetitions]
+
+const { spawn } = require("child_process");
+const fs = require("fs");
+const path = require("path");
+
+const repetitions = parseInt(process.argv[2] ?? "5", 10);
+
+const cli = require.resolve("@jazzer.js/core/dist/cli.js");
+const examples = path.join(__dirname, "..", "..", "examples");
+
+// Arguments as in the `fuzz` scripts of the examples.
+const targets = [
+	{ name: "jpeg", args: ["fuzz", "-i", "jpeg-js", "--sync"] },
+	{ name: "js-yaml", args: ["dist/fuzz", "-i", "js-yaml"] },
+	{ name: "xml", args: ["fuzz", "-i", "xml"] },
+	{
+		name: "spectral",
+		args: ["spectral-example", "-i", "spectral", "--sync"],
+	},
+];
+
+const modes = [
+	{ name: "edges", args: [] },
+	{ name: "blocks", args: ["--block_coverage"] },
+	{
+		name: "blocks + compare hooks",
+		args: ["--block_coverage", "--block_coverage_compare_hooks"],
+	},
+];
+
+// Milliseconds until libFuzzer is done with the initial corpus, or undefined
+// if the run failed before.
+function startup(target, mode) {
+	const args = [cli, ...target.args, ...mode.args, "--", "-runs=1", "-seed=1"];
+	return new Promise((resolve) => {
+		const start = process.hrtime.bigint();
+		let time;
+		let stderr = "";
+		const proc = spawn(process.execPath, args, {
+			cwd: path.join(examples, target.name),
+		});
+		proc.stdout.resume();
+		proc.stderr.setEncoding("utf8");
+		proc.stderr.on("data", (data) => {
+			stderr += data;
+			if (time === undefined && stderr.includes("INITED")) {
+				time = Number(process.hrtime.bigint() - start) / 1e6;
+			}
+		});
+		proc.on("close", () => resolve(time));
+	});
+}
+
+function median(values) {
+	const sorted = [...values].sort((a, b) => a - b);
+	return sorted[Math.floor(sorted.length / 2)];
+}
+
+async function main() {
+	const results = [];
+	for (const target of targets) {
+		if (!fs.existsSync(path.join(examples, target.name, "node_modules"))) {
+			console.error(`Skipping ${target.name}, it is not installed.`);
+			continue;
+		}
+		const row = { example: target.name };
+		for (const mode of modes) {
+			const times = [];
+			for (let i = 0; i < repetitions; i++) {
+				times.push(await startup(target, mode));
+			}
+			row[`${mode.name} (ms)`] = times.includes(undefined)
+				? "failed"
+				: Math.round(median(times));
+		}
+		results.push(row);
+	}
+
+	if (process.env.JAZZER_BENCH_JSON) {
+		console.log(JSON.stringify(results, null, 2));
+	} else {
+		console.log(`Median of ${repetitions} runs per example and mode`);
+		console.table(results);
+	}
+}
+
+main();
@@ -4,6 +4,9 @@ cd ..
 npm install
 npm run build
 npm run build --workspace='@jazzer.js/fuzzer'
+# The build above uses V8 and only loads into the current Node version, the
+# other versions fall back to a build using Node-API only.
+npm run build:node-api --workspace='@jazzer.js/fuzzer'
 
 sed_version_and_mv() {
     while read data; do
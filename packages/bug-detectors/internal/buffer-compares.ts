@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import {
+	guideTowardsBytesContainment,
+	guideTowardsEqualBytes,
+} from "@jazzer.js/core";
+import { callSiteId, registerAfterHook } from "@jazzer.js/hooking";
+
+/**
+ * Importing this file adds "after-hooks" to the comparison and search functions of `Buffer`, so
+ * that the fuzzer learns the bytes binary formats compare their input with, e.g. magic numbers
+ * and signatures. This does not report any findings.
+ *
+ * The hooks only act on failed comparisons and pass the compared bytes to the fuzzer without
+ * copying them. `Buffer.prototype.includes` is implemented with `indexOf` and needs no hook.
+ *
+ * The functions are hooked in place in the built-in `buffer` module, so the hook ID passed to the
+ * hooks is the same for all calls. The ID of the call site is only derived once a comparison
+ * failed, instead of for every call.
+ */
+
+const moduleName = "buffer";
+
+registerAfterHook(
+	"Buffer.prototype.equals",
+	moduleName,
+	false,
+	(thisPtr: Buffer, params: unknown[], _hookId: number, result: boolean) => {
+		if (!result) {
+			guideTowardsEqualBytes(thisPtr, params[0] as Uint8Array, callSiteId());
+		}
+		return result;
+	},
+);
+
+registerAfterHook(
+	"Buffer.prototype.compare",
+	moduleName,
+	false,
+	(thisPtr: Buffer, params: unknown[], _hookId: number, result: number) => {
+		if (result !== 0) {
+			const [target, targetStart, targetEnd, sourceStart, sourceEnd] =
+				params as [Uint8Array, number?, number?, number?, number?];
+			guideTowardsEqualBytes(
+				thisPtr.subarray(sourceStart, sourceEnd),
+				target.subarray(targetStart, targetEnd),
+				callSiteId(),
+			);
+		}
+		return result;
+	},
+);
+
+registerAfterHook(
+	"Buffer.compare",
+	moduleName,
+	false,
+	(_thisPtr: unknown, params: unknown[], _hookId: number, result: number) => {
+		if (result !== 0) {
+			guideTowardsEqualBytes(
+				params[0] as Uint8Array,
+				params[1] as Uint8Array,
+				callSiteId(),
+			);
+		}
+		return result;
+	},
+);
+
+for (const functionName of ["indexOf", "lastIndexOf"]) {
+	registerAfterHook(
+		`Buffer.prototype.${functionName}`,
+		moduleName,
+		false,
+		(thisPtr: Buffer, params: unknown[], _hookId: number, result: number) => {
+			if (result === -1) {
+				const needle = searchedBytes(params);
+				if (needle) {
+					guideTowardsBytesContainment(needle, thisPtr, callSiteId());
+				}
+			}
+			return result;
+		},
+	);
+}
+
+// The searched value is a string, a Buffer, a Uint8Array or a number. Strings
+// are encoded like by the search itself, with the encoding passed as second or
+// third argument.
+function searchedBytes(params: unknown[]): Uint8Array | undefined {
+	const [value, byteOffset, encoding] = params;
+	if (typeof value === "string") {
+		const valueEncoding =
+			typeof byteOffset === "string" ? byteOffset : encoding;
+		return Buffer.from(value, valueEncoding as BufferEncoding | undefined);
+	}
+	if (ArrayBuffer.isView(value)) {
+		return value as Uint8Array;
+	}
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import {
+	monitorHeap,
+	registerAfterEachCallback,
+	reportFinding,
+} from "@jazzer.js/core";
+
+/**
+ * Importing this file reports a finding if the V8 heap is about to be exhausted, or if it keeps
+ * growing over many full garbage collections, i.e. the fuzz target leaks memory.
+ *
+ * The heap is watched by the native addon, which can't run JS while the garbage collector runs.
+ * It passes its observations on in a shared array, which is checked after each fuzz test.
+ */
+
+// Layout of the state shared with the addon, see heap_monitor.cpp.
+const STATUS = 0;
+const USED_BYTES = 1;
+const LIMIT_BYTES = 2;
+const BASELINE_BYTES = 3;
+const GROWING_GCS = 4;
+const STATE_SIZE = 5;
+
+const enum HeapStatus {
+	Ok = 0,
+	NearHeapLimit = 1,
+	Leak = 2,
+	Reported = 3,
+}
+
+const state = new Float64Array(STATE_SIZE);
+if (monitorHeap) {
+	monitorHeap(state);
+	registerAfterEachCallback(detectHeapExhaustion);
+} else {
+	console.error(
+		"WARN: [Heap Exhaustion] The native addon wasn't built for this version " +
+			"of Node, the bug detector is turned off.",
+	);
+}
+
+function detectHeapExhaustion() {
+	const status = state[STATUS];
+	if (status === HeapStatus.Ok || status === HeapStatus.Reported) {
+		return;
+	}
+	// The addon raised the heap limit, so that there is room left to report the finding.
+	state[STATUS] = HeapStatus.Reported;
+	const limit = megabytes(state[LIMIT_BYTES]);
+	if (status === HeapStatus.NearHeapLimit) {
+		reportFinding(
+			`Out of Memory\n    The JavaScript heap reached its limit of ${limit} MB.`,
+			false,
+		);
+	} else {
+		const from = megabytes(state[BASELINE_BYTES]);
+		const to = megabytes(state[USED_BYTES]);
+		reportFinding(
+			`Memory Leak\n    The live JavaScript heap grew from ${from} MB to ${to} MB ` +
+				`in the last ${state[GROWING_GCS]} full garbage collections ` +
+				`(limit: ${limit} MB).`,
+			false,
+		);
+	}
+}
+
+function megabytes(bytes: number): number {
+	return Math.round(bytes / (1024 * 1024));
+}
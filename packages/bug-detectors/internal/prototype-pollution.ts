@@ -21,6 +21,7 @@ import { AssignmentExpression, Identifier, Node } from "@babel/types";
 
 import {
 	addDictionary,
+	fingerprintPrototypes,
 	getJazzerJsGlobal,
 	instrumentationGuard,
 	registerAfterEachCallback,
@@ -109,6 +110,12 @@ globalThis.PrototypePollution = {
 	protoSnapshotsEqual: protoSnapshotsEqual,
 };
 
+// The instrumentation depends on the configuration, cached instrumentation
+// results are only reused for the same configuration.
+function instrumentationState() {
+	return config.getInstrumentAssignmentsAndVariableDeclarations();
+}
+
 registerInstrumentationPlugin((): PluginTarget => {
 	function getIdentifierFromAssignmentExpression(
 		expr: AssignmentExpression,
@@ -233,7 +240,7 @@ registerInstrumentationPlugin((): PluginTarget => {
 			},
 		},
 	};
-});
+}, instrumentationState);
 
 // These objects will be used to detect prototype pollution.
 // Using global arrays for performance reasons.
@@ -270,6 +277,9 @@ type ProtoSnapshot = {
 // Compute prototype snapshots of each selected basic object before any fuzz tests are run.
 // These snapshots are used to detect prototype pollution after each fuzz test.
 let BASIC_PROTO_SNAPSHOTS = computeBasicPrototypeSnapshots(BASIC_OBJECTS);
+// Fingerprint of the same prototypes, checked after each fuzz test instead of
+// taking new snapshots, which is only done if the fingerprint changed.
+let BASIC_PROTO_FINGERPRINT = fingerprintPrototypes(BASIC_OBJECTS);
 
 if (getJazzerJsGlobal("vmContext")) {
 	const vmContext = getJazzerJsGlobal("vmContext") as vm.Context;
@@ -283,6 +293,7 @@ if (getJazzerJsGlobal("vmContext")) {
 	// TODO: This should be updated every time Jest sacks the current vm context.
 	BASIC_OBJECTS = vm.runInContext('[{},[],"",42,true,()=>{}]', vmContext);
 	BASIC_PROTO_SNAPSHOTS = computeBasicPrototypeSnapshots(BASIC_OBJECTS);
+	BASIC_PROTO_FINGERPRINT = fingerprintPrototypes(BASIC_OBJECTS);
 }
 
 export function computeBasicPrototypeSnapshots(
@@ -323,7 +334,14 @@ function getProtoSnapshot(obj: any): ProtoSnapshot {
 }
 
 registerAfterEachCallback(function detectPrototypePollution() {
+	const fingerprint = fingerprintPrototypes(BASIC_OBJECTS);
+	if (fingerprint === BASIC_PROTO_FINGERPRINT) {
+		return;
+	}
 	detectPrototypePollutionOfBasicObjects(BASIC_PROTO_SNAPSHOTS, BASIC_OBJECTS);
+	// Changes that are not reported become the new baseline, so that they
+	// are not compared again after every following fuzz test.
+	BASIC_PROTO_FINGERPRINT = fingerprint;
 });
 
 function detectPrototypePollutionOfBasicObjects(
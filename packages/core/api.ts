@@ -37,7 +37,16 @@ export {
 
 export const guideTowardsEquality = fuzzer.tracer.guideTowardsEquality;
 export const guideTowardsContainment = fuzzer.tracer.guideTowardsContainment;
+export const guideTowardsEqualBytes = fuzzer.tracer.guideTowardsEqualBytes;
+export const guideTowardsBytesContainment =
+	fuzzer.tracer.guideTowardsBytesContainment;
 export const exploreState = fuzzer.tracer.exploreState;
+// Cheap check for changes of the prototypes of the given objects, used by the
+// prototype pollution bug detector.
+export const fingerprintPrototypes = fuzzer.fingerprintPrototypes;
+// Watch the V8 heap for imminent exhaustion and leaks, used by the heap
+// exhaustion bug detector.
+export const monitorHeap = fuzzer.monitorHeap;
 
 // Export jazzer object for backwards compatibility.
 export const jazzer = {
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import { Session } from "inspector";
+import { fileURLToPath } from "url";
+
+import * as fuzzer from "@jazzer.js/fuzzer";
+import { Instrumentor } from "@jazzer.js/instrumentor";
+
+import { registerAfterEachCallback } from "./callback";
+
+// Counters are allocated in chunks for blocks seen for the first time.
+const CHUNK_BITS = 12;
+const CHUNK_SIZE = 1 << CHUNK_BITS;
+
+// Start and end offsets of a block are combined into one map key. Scripts
+// are far smaller than this.
+const MAX_OFFSET = 2 ** 26;
+
+// Subset of the Profiler domain types of the inspector protocol.
+interface CoverageRange {
+	startOffset: number;
+	endOffset: number;
+	count: number;
+}
+
+interface FunctionCoverage {
+	ranges: CoverageRange[];
+}
+
+interface ScriptCoverage {
+	scriptId: string;
+	url: string;
+	functions: FunctionCoverage[];
+}
+
+// Blocks of a function seen so far and their counter slots.
+class FunctionBlocks {
+	// Index of each block by its key.
+	readonly indices = new Map<number, number>();
+	readonly starts: number[] = [];
+	readonly ends: number[] = [];
+	readonly slots: number[] = [];
+	// Number of the last coverage update that reported the block.
+	readonly updates: number[] = [];
+}
+
+/**
+ * Coverage feedback from V8's block coverage instead of instrumented code.
+ *
+ * After each fuzzer iteration, the execution counts of the blocks executed
+ * during the iteration are taken from V8 and written to coverage counters
+ * registered with libFuzzer, one per block.
+ *
+ * V8 leaves out blocks that were executed as often as their enclosing block,
+ * so a block only gets its counter once it was reported for the first time.
+ * Afterwards, the count of the innermost reported enclosing block is used
+ * whenever the block is left out.
+ */
+export class BlockCoverage {
+	private readonly session = new Session();
+	// Blocks per function and script, null for scripts not to be fuzzed.
+	private readonly scripts = new Map<
+		string,
+		Map<number, FunctionBlocks> | null
+	>();
+	private readonly counters: Buffer[] = [];
+	private numSlots = 0;
+	private numUpdates = 0;
+
+	constructor(private readonly instrumentor: Instrumentor) {}
+
+	start() {
+		this.session.connect();
+		this.post("Profiler.enable");
+		this.post("Profiler.startPreciseCoverage", {
+			callCount: true,
+			detailed: true,
+		});
+	}
+
+	/**
+	 * Write the block counts since the last update to the coverage counters
+	 * and reset them.
+	 */
+	update() {
+		const result = this.post("Profiler.takePreciseCoverage") as {
+			result: ScriptCoverage[];
+		};
+		this.numUpdates++;
+		for (const script of result.result) {
+			const functions = this.functionsOf(script);
+			if (!functions) {
+				continue;
+			}
+			for (const { ranges } of script.functions) {
+				// Functions not called since the last update only report
+				// themselves.
+				if (ranges[0].count === 0 && ranges.length === 1) {
+					continue;
+				}
+				const key = blockKey(ranges[0]);
+				let blocks = functions.get(key);
+				if (!blocks) {
+					blocks = new FunctionBlocks();
+					functions.set(key, blocks);
+				}
+				this.updateFunction(blocks, ranges);
+			}
+		}
+	}
+
+	private updateFunction(blocks: FunctionBlocks, ranges: CoverageRange[]) {
+		for (const range of ranges) {
+			const key = blockKey(range);
+			let index = blocks.indices.get(key);
+			if (index === undefined) {
+				index = blocks.starts.length;
+				blocks.indices.set(key, index);
+				blocks.starts.push(range.startOffset);
+				blocks.ends.push(range.endOffset);
+				blocks.slots.push(this.allocateSlot());
+				blocks.updates.push(0);
+			}
+			blocks.updates[index] = this.numUpdates;
+			this.write(blocks.slots[index], range.count);
+		}
+		if (blocks.starts.length === ranges.length) {
+			return;
+		}
+
+		// Ranges are reported in pre-order, so the last range containing a
+		// block is its innermost reported enclosing block.
+		for (let index = 0; index < blocks.starts.length; index++) {
+			if (blocks.updates[index] === this.numUpdates) {
+				continue;
+			}
+			let count = 0;
+			for (const range of ranges) {
+				if (
+					range.startOffset <= blocks.starts[index] &&
+					range.endOffset >= blocks.ends[index]
+				) {
+					count = range.count;
+				}
+			}
+			this.write(blocks.slots[index], count);
+		}
+	}
+
+	private functionsOf(script: ScriptCoverage) {
+		let functions = this.scripts.get(script.scriptId);
+		if (functions === undefined) {
+			functions = this.shouldCollect(script.url) ? new Map() : null;
+			this.scripts.set(script.scriptId, functions);
+		}
+		return functions;
+	}
+
+	private shouldCollect(url: string): boolean {
+		if (url.startsWith("file://")) {
+			url = fileURLToPath(url);
+		} else if (!url.startsWith("/") && !/^[a-zA-Z]:\\/.test(url)) {
+			// Node.js internals, eval'd code and other scripts without a file.
+			return false;
+		}
+		return this.instrumentor.shouldInstrumentForFuzzing(url);
+	}
+
+	private allocateSlot(): number {
+		if (this.numSlots % CHUNK_SIZE === 0) {
+			this.counters.push(
+				fuzzer.coverageTracker.createModuleCounters(CHUNK_SIZE),
+			);
+		}
+		return this.numSlots++;
+	}
+
+	private write(slot: number, count: number) {
+		if (count > 0) {
+			this.counters[slot >>> CHUNK_BITS][slot & (CHUNK_SIZE - 1)] =
+				count > 255 ? 255 : count;
+		}
+	}
+
+	// Messages to a session in the same thread are dispatched synchronously.
+	private post(method: string, params?: object): object {
+		// Declared with casts, as TypeScript doesn't see the callback run.
+		let response = undefined as object | undefined;
+		let failure = null as Error | null;
+		this.session.post(method, params, (error, result) => {
+			failure = error;
+			response = result;
+		});
+		if (failure) {
+			throw failure;
+		}
+		if (!response) {
+			throw new Error(`No response to inspector message ${method}`);
+		}
+		return response;
+	}
+}
+
+function blockKey(range: CoverageRange): number {
+	return range.startOffset * MAX_OFFSET + range.endOffset;
+}
+
+/**
+ * Collect coverage feedback from V8's block coverage, for the modules the
+ * instrumentor would instrument otherwise.
+ */
+export function startBlockCoverage(instrumentor: Instrumentor): BlockCoverage {
+	const coverage = new BlockCoverage(instrumentor);
+	coverage.start();
+	registerAfterEachCallback(() => coverage.update());
+	return coverage;
+}
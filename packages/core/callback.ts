@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+import { IterationPhase } from "@jazzer.js/fuzzer";
+
 import { getOrSetJazzerJsGlobal } from "./globals";
 
 export type Thunk = () => void;
@@ -25,6 +27,7 @@ export type Thunk = () => void;
 export class Callbacks {
 	private _afterEachCallbacks: Array<Thunk> = [];
 	private _beforeEachCallbacks: Array<Thunk> = [];
+	private _recordPhase?: (phase: IterationPhase, nanoseconds: number) => void;
 
 	registerAfterEachCallback(callback: Thunk) {
 		this._afterEachCallbacks.push(callback);
@@ -34,12 +37,35 @@ export class Callbacks {
 		this._beforeEachCallbacks.push(callback);
 	}
 
+	/**
+	 * Report the duration of each run of the callbacks to the given function,
+	 * used to profile the fuzzer iterations.
+	 */
+	profileWith(
+		recordPhase: (phase: IterationPhase, nanoseconds: number) => void,
+	) {
+		this._recordPhase = recordPhase;
+	}
+
 	runAfterEachCallbacks() {
-		this._afterEachCallbacks.forEach((c) => c());
+		this.run(this._afterEachCallbacks, IterationPhase.AfterEach);
 	}
 
 	runBeforeEachCallbacks() {
-		this._beforeEachCallbacks.forEach((c) => c());
+		this.run(this._beforeEachCallbacks, IterationPhase.BeforeEach);
+	}
+
+	private run(callbacks: Array<Thunk>, phase: IterationPhase) {
+		if (!this._recordPhase) {
+			callbacks.forEach((c) => c());
+			return;
+		}
+		const start = process.hrtime.bigint();
+		try {
+			callbacks.forEach((c) => c());
+		} finally {
+			this._recordPhase(phase, Number(process.hrtime.bigint() - start));
+		}
 	}
 }
 
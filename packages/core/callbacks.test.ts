@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 
+import { IterationPhase } from "@jazzer.js/fuzzer";
+
 import {
+	Callbacks,
 	getCallbacks,
 	registerAfterEachCallback,
 	registerBeforeEachCallback,
@@ -44,4 +47,17 @@ describe("callbacks", () => {
 		callbacks.runAfterEachCallbacks();
 		expect(callback).toHaveBeenCalledTimes(3);
 	});
+
+	it("reports the duration of the callbacks when profiling", () => {
+		const callbacks = new Callbacks();
+		const recordPhase = jest.fn();
+		callbacks.registerAfterEachCallback(jest.fn());
+		callbacks.profileWith(recordPhase);
+		callbacks.runBeforeEachCallbacks();
+		callbacks.runAfterEachCallbacks();
+		expect(recordPhase.mock.calls).toEqual([
+			[IterationPhase.BeforeEach, expect.any(Number)],
+			[IterationPhase.AfterEach, expect.any(Number)],
+		]);
+	});
 });
@@ -184,6 +184,102 @@ yargs(process.argv.slice(2))
 					group: "Fuzzer:",
 					type: "boolean",
 				})
+				.option("pruneCounters", {
+					alias: ["prune_counters"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.pruneCounters,
+					)}`,
+					describe:
+						"Leave out coverage counters that are always hit together " +
+						"with other counters, to reduce the instrumentation overhead.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
+				.option("gcBudget", {
+					alias: ["gc_budget"],
+					defaultDescription: `${JSON.stringify(defaultCLIOptions.gcBudget)}`,
+					describe:
+						"Run a full garbage collection between iterations once the " +
+						"heap grew by the given number of megabytes, so that V8 " +
+						"doesn't have to collect in the middle of an iteration.",
+					group: "Fuzzer:",
+					type: "number",
+				})
+				.option("profile", {
+					defaultDescription: `${JSON.stringify(defaultCLIOptions.profile)}`,
+					describe:
+						"Record the duration of the phases of each iteration and " +
+						"print a summary after libFuzzer's final stats.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
+				.option("slowInputDirectory", {
+					alias: ["slow_input_directory"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.slowInputDirectory,
+					)}`,
+					describe:
+						"Profile the iterations and write inputs taking much longer " +
+						"than the typical iteration to the given directory.",
+					group: "Fuzzer:",
+					type: "string",
+				})
+				.option("blockCoverage", {
+					alias: ["block_coverage"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.blockCoverage,
+					)}`,
+					describe:
+						"Take the coverage feedback from V8's block coverage instead " +
+						"of instrumenting the code. Starts faster, but only tracks " +
+						"blocks instead of edges.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
+				.option("blockCoverageCompareHooks", {
+					alias: ["block_coverage_compare_hooks"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.blockCoverageCompareHooks,
+					)}`,
+					describe:
+						"Still rewrite comparisons to guide the mutations with block " +
+						"coverage. Needs a Babel pass over every included module.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
+				.option("lazyInstrumentation", {
+					alias: ["lazy_instrumentation"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.lazyInstrumentation,
+					)}`,
+					describe:
+						"Instrument functions on their first call instead of when " +
+						"their module is loaded, to speed up loading large modules.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
+				.option("instrumentationCache", {
+					alias: ["instrumentation_cache"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.instrumentationCache,
+					)}`,
+					describe:
+						"Directory to cache instrumented modules in, to reuse them " +
+						"in other processes and later runs.",
+					group: "Fuzzer:",
+					type: "string",
+				})
+				.option("instrumentationWorkers", {
+					alias: ["instrumentation_workers"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.instrumentationWorkers,
+					)}`,
+					describe:
+						"Number of worker threads instrumenting the included files " +
+						"in parallel before the fuzz target is loaded.",
+					group: "Fuzzer:",
+					type: "number",
+				})
 				.option("timeout", {
 					defaultDescription: `${JSON.stringify(defaultCLIOptions.timeout)}`,
 					describe: "Timeout in milliseconds for each fuzz test execution.",
@@ -196,6 +292,17 @@ yargs(process.argv.slice(2))
 					group: "Fuzzer:",
 					type: "boolean",
 				})
+				.option("inlineAsync", {
+					alias: ["inline_async"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.inlineAsync,
+					)}`,
+					describe:
+						"Run iterations of an async fuzz target back to back, as long " +
+						"as they don't have to wait for the event loop, e.g. for I/O.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
 				.option("verbose", {
 					alias: "v",
 					defaultDescription: `${JSON.stringify(defaultCLIOptions.verbose)}`,
@@ -203,6 +310,18 @@ yargs(process.argv.slice(2))
 					group: "Fuzzer:",
 					type: "boolean",
 				})
+				.option("zeroCopyInput", {
+					alias: ["zero_copy_input"],
+					defaultDescription: `${JSON.stringify(
+						defaultCLIOptions.zeroCopyInput,
+					)}`,
+					describe:
+						"Pass the fuzzer input to the fuzz target without copying it. " +
+						"The input is only valid during the fuzz target invocation " +
+						"and must not be modified.",
+					group: "Fuzzer:",
+					type: "boolean",
+				})
 
 				.option("coverage", {
 					alias: "cov",
@@ -26,13 +26,17 @@ import * as tmp from "tmp";
 import * as fuzzer from "@jazzer.js/fuzzer";
 import * as hooking from "@jazzer.js/hooking";
 import {
+	EdgeIdStrategy,
 	FileSyncIdStrategy,
 	Instrumentor,
+	LazyFunctionRegistry,
+	lazyFunctions,
 	MemorySyncIdStrategy,
 	registerEsmLoaderHooks,
 	registerInstrumentor,
 } from "@jazzer.js/instrumentor";
 
+import { startBlockCoverage } from "./blockCoverage";
 import { getCallbacks } from "./callback";
 import {
 	cleanErrorStack,
@@ -43,7 +47,13 @@ import {
 	reportFinding,
 } from "./finding";
 import { getJazzerJsGlobal, jazzerJs } from "./globals";
-import { buildFuzzerOption, OptionsManager } from "./options";
+import { preInstrument } from "./preInstrument";
+import {
+	buildExecutionOptions,
+	buildFuzzerOption,
+	OptionsManager,
+	symbolizesCounters,
+} from "./options";
 import { ensureFilepath, importModule } from "./utils";
 
 // Remove temporary files on exit
@@ -76,6 +86,7 @@ export class FuzzingResult {
 declare global {
 	var Fuzzer: fuzzer.Fuzzer;
 	var HookManager: hooking.HookManager;
+	var LazyFunctions: LazyFunctionRegistry;
 	var __coverage__: libCoverage.CoverageMapData;
 	// WARNING: since every fuzz test has a cloned OptionsManager, into which some fuzz-test specific options are merged,
 	// (e.g. the test name), the options object stored in this global variable is not necessarily the same as the one used
@@ -107,20 +118,66 @@ export async function initFuzzing(
 	options: OptionsManager,
 ): Promise<Instrumentor> {
 	const seed = resolveInstrumentationSeed(options);
-	const instrumentor = new Instrumentor(
+	// Instrumentation workers hand over their results through the cache.
+	const cacheDirectory =
+		options.get("instrumentationCache") ||
+		(options.get("instrumentationWorkers") > 0
+			? tmp.dirSync({ unsafeCleanup: true }).name
+			: "");
+	const instrumentor = createInstrumentor(
+		options,
+		seed,
+		cacheDirectory,
+		options.get("idSyncFile")
+			? new FileSyncIdStrategy(options.get("idSyncFile"))
+			: new MemorySyncIdStrategy(),
+	);
+	registerInstrumentor(instrumentor);
+	if (options.get("blockCoverage") && !options.get("dryRun")) {
+		startBlockCoverage(instrumentor);
+	}
+
+	// Hook IDs are determined in the native addon, which is only loaded on
+	// the main thread, if it has access to the JS stack.
+	if (fuzzer.fuzzer.callSiteId) {
+		hooking.useNativeCallSiteIds(fuzzer.fuzzer.callSiteId);
+	}
+	await loadBugDetectorsAndHooks(options);
+
+	// Send the finalized hook definitions to the ESM loader thread
+	// so it can apply function-hook transforms to user modules.
+	// This must happen after finalizeHooks (hooks are complete) and
+	// before loadFuzzFunction (user modules are imported).
+	instrumentor.sendHooksToLoader();
+
+	return instrumentor;
+}
+
+export function createInstrumentor(
+	options: OptionsManager,
+	seed: number,
+	cacheDirectory: string,
+	idStrategy: EdgeIdStrategy,
+): Instrumentor {
+	return new Instrumentor(
 		options.get("includes"),
 		options.get("excludes"),
 		options.get("customHooks"),
 		options.get("coverage"),
 		options.get("dryRun"),
-		options.get("idSyncFile")
-			? new FileSyncIdStrategy(options.get("idSyncFile"))
-			: new MemorySyncIdStrategy(),
+		idStrategy,
 		undefined, // sourceMapRegistry — use default
 		seed,
+		options.get("pruneCounters"),
+		options.get("blockCoverage"),
+		options.get("lazyInstrumentation"),
+		cacheDirectory,
+		symbolizesCounters(options.get("fuzzerOptions")),
+		options.get("blockCoverageCompareHooks"),
 	);
-	registerInstrumentor(instrumentor);
+}
 
+export async function loadBugDetectorsAndHooks(options: OptionsManager) {
 	// Dynamic import works only with javascript files, so we have to manually specify the directory with the
 	// transpiled bug detector files.
 	const possibleBugDetectorFiles = getFilteredBugDetectorPaths(
@@ -148,14 +205,6 @@ export async function initFuzzing(
 	await hooking.hookManager.finalizeHooks(
 		getJazzerJsGlobal<vm.Context>("vmContext") ?? globalThis,
 	);
-
-	// Send the finalized hook definitions to the ESM loader thread
-	// so it can apply function-hook transforms to user modules.
-	// This must happen after finalizeHooks (hooks are complete) and
-	// before loadFuzzFunction (user modules are imported).
-	instrumentor.sendHooksToLoader();
-
-	return instrumentor;
 }
 
 export function registerGlobals(
@@ -166,6 +215,7 @@ export function registerGlobals(
 	globals.forEach((global) => {
 		global.Fuzzer = fuzzer.fuzzer;
 		global.HookManager = hooking.hookManager;
+		global.LazyFunctions = lazyFunctions;
 		global.options = options;
 		global.JazzerJS = jazzerJs;
 	});
@@ -222,6 +272,7 @@ export async function startFuzzing(
 	const instrumentor = await initFuzzing(options);
 	registerEsmLoaderHooks(instrumentor);
 	instrumentor.sendHooksToLoader();
+	await preInstrument(instrumentor, options);
 	const fuzzFn = await loadFuzzFunction(options);
 	const findingAwareFuzzFn = asFindingAwareFuzzFn(fuzzFn);
 	return startFuzzingNoInit(findingAwareFuzzFn, options).finally(() => {
@@ -250,6 +301,13 @@ export async function startFuzzingNoInit(
 
 	try {
 		const fuzzerOptions = buildFuzzerOption(options);
+		const executionOptions = buildExecutionOptions(options);
+		if (executionOptions.profile) {
+			getCallbacks().profileWith(fuzzer.fuzzer.recordIterationPhase);
+		}
+		if (executionOptions.slowInputDirectory) {
+			fs.mkdirSync(executionOptions.slowInputDirectory, { recursive: true });
+		}
 		if (options.get("sync")) {
 			await fuzzer.fuzzer.startFuzzing(
 				fuzzFn,
@@ -260,9 +318,14 @@ export async function startFuzzingNoInit(
 				// Hence, we pass a callback function to the native fuzzer and
 				// register a SIGINT handler there.
 				signalHandler,
+				executionOptions,
 			);
 		} else {
-			await fuzzer.fuzzer.startFuzzingAsync(fuzzFn, fuzzerOptions);
+			await fuzzer.fuzzer.startFuzzingAsync(
+				fuzzFn,
+				fuzzerOptions,
+				executionOptions,
+			);
 		}
 		// Fuzzing ended without a finding, due to -max_total_time or -runs.
 		return reportFuzzingResult(undefined, options.get("expectedErrors"));
@@ -22,6 +22,7 @@ import {
 	OptionsManager,
 	OptionSource,
 	spawnsSubprocess,
+	symbolizesCounters,
 	validateKeySource,
 } from "./options";
 
@@ -312,6 +313,17 @@ describe("buildLibFuzzerOptions", () => {
 			expect(spawnsSubprocess(["123"])).toBeFalsy();
 		});
 	});
+
+	describe("symbolizesCounters", () => {
+		it("checks if libFuzzer flags referring to source locations are present", () => {
+			expect(symbolizesCounters(["-print_pcs=1"])).toBeTruthy();
+			expect(symbolizesCounters(["-print_coverage=0"])).toBeFalsy();
+			expect(
+				symbolizesCounters(["-runs=10", "-focus_function=parse"]),
+			).toBeTruthy();
+			expect(symbolizesCounters(["-use_value_profile=1"])).toBeFalsy();
+		});
+	});
 });
 
 function expectDefaultsExceptKeys(
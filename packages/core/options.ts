@@ -19,6 +19,8 @@ import * as util from "util";
 
 import * as tmp from "tmp";
 
+import type { ExecutionOptions } from "@jazzer.js/fuzzer";
+
 import { useDictionaryByParams } from "./dictionary";
 import { replaceAll } from "./utils";
 
@@ -30,6 +32,10 @@ import { replaceAll } from "./utils";
  * options.
  */
 export interface Options {
+	// Take coverage feedback from V8's block coverage instead of instrumenting the code.
+	blockCoverage: boolean;
+	// Rewrite comparisons for the compare hooks even with block coverage.
+	blockCoverageCompareHooks: boolean;
 	// Enable source code coverage report generation.
 	coverage: boolean;
 	// Directory to write coverage reports to.
@@ -54,18 +60,36 @@ export interface Options {
 	fuzzerOptions: string[];
 	// `fuzzTarget` is the name of a module exporting the fuzz function `fuzzEntryPoint`.
 	fuzzTarget: string;
+	// Heap growth in MB after which garbage is collected between iterations.
+	gcBudget: number;
 	// Internal: File to sync coverage IDs in fork mode.
 	idSyncFile: string;
 	// Part of filepath names to include in the instrumentation.
 	includes: string[];
+	// Run async fuzz targets without an event loop turn per iteration, if possible.
+	inlineAsync: boolean;
+	// Directory of the on-disk cache of instrumented modules, if any.
+	instrumentationCache: string;
+	// Number of worker threads instrumenting the included files up front.
+	instrumentationWorkers: number;
+	// Instrument functions on their first call instead of when they are loaded.
+	lazyInstrumentation: boolean;
 	// Fuzzing mode.
 	mode: "fuzzing" | "regression";
+	// Record the duration of the phases of each iteration.
+	profile: boolean;
+	// Leave out coverage counters that are always hit together with others.
+	pruneCounters: boolean;
+	// Directory to write unusually slow inputs to, enables profiling.
+	slowInputDirectory: string;
 	// Whether to run the fuzzer in sync mode or not.
 	sync: boolean;
 	// Timeout for one fuzzing iteration in milliseconds.
 	timeout: number;
 	// Verbose logging.
 	verbose: boolean;
+	// Pass the fuzzer input to the fuzz target without copying it.
+	zeroCopyInput: boolean;
 }
 
 export type OptionWithSource<K extends keyof Options> = {
@@ -93,6 +117,8 @@ const allowedFuzzTestOptions = [
 export type AllowedFuzzTestOptions = (typeof allowedFuzzTestOptions)[number];
 
 export const defaultCLIOptions: Options = Object.freeze({
+	blockCoverage: false,
+	blockCoverageCompareHooks: false,
 	coverage: false,
 	coverageDirectory: "coverage",
 	coverageReporters: ["json", "text", "lcov", "clover"], // default Jest reporters
@@ -105,12 +131,21 @@ export const defaultCLIOptions: Options = Object.freeze({
 	fuzzEntryPoint: "fuzz",
 	fuzzerOptions: [],
 	fuzzTarget: "",
+	gcBudget: 0,
 	idSyncFile: "",
 	includes: ["*"],
+	inlineAsync: false,
+	instrumentationCache: "",
+	instrumentationWorkers: 0,
+	lazyInstrumentation: false,
 	mode: "fuzzing",
+	profile: false,
+	pruneCounters: false,
+	slowInputDirectory: "",
 	sync: false,
 	timeout: 5000, // default Jest timeout
 	verbose: false,
+	zeroCopyInput: false,
 });
 
 export const defaultJestOptions: Options = Object.freeze({
@@ -436,6 +471,19 @@ export function buildFuzzerOption(options: OptionsManager) {
 	return params;
 }
 
+export function buildExecutionOptions(
+	options: OptionsManager,
+): ExecutionOptions {
+	return {
+		zeroCopyInput: options.get("zeroCopyInput"),
+		inlineAsync: options.get("inlineAsync"),
+		profile:
+			options.get("profile") || options.get("slowInputDirectory") !== "",
+		slowInputDirectory: options.get("slowInputDirectory"),
+		gcBudget: options.get("gcBudget"),
+	};
+}
+
 export function printOptions(options: OptionsManager, infix = "") {
 	if (process.env.JAZZER_DEBUG) {
 		console.error(
@@ -517,15 +565,31 @@ function prepareLibFuzzerArg0(fuzzerOptions: string[]): string {
 // These flags cause libFuzzer to spawn subprocesses.
 const SUBPROCESS_FLAGS = ["fork", "jobs", "merge", "minimize_crash"];
 
-export function spawnsSubprocess(fuzzerOptions: string[]): boolean {
+// These flags make libFuzzer resolve coverage counters to source locations.
+const SYMBOLIZING_FLAGS = [
+	"print_pcs",
+	"print_funcs",
+	"print_coverage",
+	"focus_function",
+];
+
+function setsAnyFlag(fuzzerOptions: string[], flags: string[]): boolean {
 	return fuzzerOptions.some((option) =>
-		SUBPROCESS_FLAGS.some((flag) => {
+		flags.some((flag) => {
 			const name = `-${flag}=`;
 			return option.startsWith(name) && !option.startsWith("0", name.length);
 		}),
 	);
 }
 
+export function spawnsSubprocess(fuzzerOptions: string[]): boolean {
+	return setsAnyFlag(fuzzerOptions, SUBPROCESS_FLAGS);
+}
+
+export function symbolizesCounters(fuzzerOptions: string[]): boolean {
+	return setsAnyFlag(fuzzerOptions, SYMBOLIZING_FLAGS);
+}
+
 function createWrapperScript(fuzzerOptions: string[]) {
 	const jazzerArgs = process.argv.filter(
 		(arg) => arg !== "--" && fuzzerOptions.indexOf(arg) === -1,
@@ -539,6 +603,10 @@ function createWrapperScript(fuzzerOptions: string[]) {
 		});
 		jazzerArgs.push("--id_sync_file", idSyncFile.name);
 		fs.closeSync(idSyncFile.fd);
+		// The edge ID table of the temporary ID sync file is not reused either.
+		process.on("exit", () =>
+			fs.rmSync(`${idSyncFile.name}.table`, { force: true }),
+		);
 	}
 
 	const isWindows = process.platform === "win32";
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import * as fs from "fs";
+import * as path from "path";
+import { Worker } from "worker_threads";
+
+import { Instrumentor } from "@jazzer.js/instrumentor";
+
+import { OptionsManager, OptionsWithSource } from "./options";
+
+// Extensions of the CommonJS modules instrumented by the require hook. ES
+// modules are instrumented by the loader thread with other plugins.
+const EXTENSIONS = [".js", ".cjs"];
+
+export interface PreInstrumentationData {
+	options: OptionsWithSource;
+	seed: number;
+	cacheDirectory: string;
+	files: string[];
+}
+
+/**
+ * Instrument the included files below the working directory in worker
+ * threads before the fuzz target is loaded.
+ *
+ * The workers store the instrumented files in the instrumentation cache, so
+ * that the require hook only has to look them up.  Edge IDs are assigned when
+ * the modules are loaded from the cache, in the same order as without the
+ * workers.  Files the workers didn't get to, e.g. due to errors, are simply
+ * instrumented when they are loaded.
+ */
+export async function preInstrument(
+	instrumentor: Instrumentor,
+	options: OptionsManager,
+): Promise<void> {
+	const numWorkers = options.get("instrumentationWorkers");
+	if (
+		numWorkers <= 0 ||
+		instrumentor.dryRun ||
+		instrumentor.lazyInstrumentationEnabled ||
+		!instrumentor.instrumentationCacheDirectory
+	) {
+		return;
+	}
+
+	const start = Date.now();
+	const files = findIncludedFiles(process.cwd(), instrumentor);
+	const workers = Math.min(numWorkers, files.length);
+	await Promise.all(
+		Array.from({ length: workers }, (_, worker) =>
+			runWorker({
+				options: options.getOptionsWithSource(),
+				seed: instrumentor.seed,
+				cacheDirectory: instrumentor.instrumentationCacheDirectory,
+				files: files.filter((_, index) => index % workers === worker),
+			}),
+		),
+	);
+	if (process.env.JAZZER_DEBUG) {
+		console.error(
+			`INFO: Instrumented ${files.length} files in ${workers} workers ` +
+				`in ${Date.now() - start} ms`,
+		);
+	}
+}
+
+function findIncludedFiles(
+	directory: string,
+	instrumentor: Instrumentor,
+	files: string[] = [],
+): string[] {
+	let entries: fs.Dirent[];
+	try {
+		entries = fs.readdirSync(directory, { withFileTypes: true });
+	} catch {
+		return files;
+	}
+	for (const entry of entries) {
+		const entryPath = path.join(directory, entry.name);
+		// Symbolic links are not followed, so that there are no cycles.
+		if (entry.isDirectory()) {
+			if (
+				!entry.name.startsWith(".") &&
+				!isExcludedDirectory(entryPath, instrumentor)
+			) {
+				findIncludedFiles(entryPath, instrumentor, files);
+			}
+		} else if (
+			entry.isFile() &&
+			EXTENSIONS.includes(path.extname(entry.name)) &&
+			instrumentor.shouldInstrumentForFuzzing(entryPath)
+		) {
+			files.push(entryPath);
+		}
+	}
+	return files;
+}
+
+// Whether all files below the directory are excluded, e.g. in node_modules.
+// The exclude patterns match anywhere in the path of a file, so a pattern
+// matching the directory matches all of its files.
+function isExcludedDirectory(
+	directory: string,
+	instrumentor: Instrumentor,
+): boolean {
+	const prefix = directory + path.sep;
+	return instrumentor.excludePatterns.some((exclude) =>
+		prefix.includes(exclude),
+	);
+}
+
+function runWorker(data: PreInstrumentationData): Promise<void> {
+	return new Promise((resolve) => {
+		const worker = new Worker(
+			path.join(__dirname, "preInstrumentWorker.js"),
+			{ workerData: data },
+		);
+		// The files of a failed worker are instrumented when they are loaded,
+		// which costs the start-up time the workers should save.
+		worker.on("error", (e) => {
+			console.error(`WARN: Instrumentation worker failed: ${e}`);
+		});
+		worker.on("exit", () => resolve());
+	});
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Worker thread of the pre-instrumentation, see preInstrument.ts.
+ *
+ * The worker sets up the instrumentation just like the main thread, with the
+ * same options, bug detectors and hooks, so that its results are stored in
+ * the instrumentation cache under the keys the main thread looks up.
+ */
+
+import * as fs from "fs";
+import Module from "module";
+import { workerData } from "worker_threads";
+
+import type { PreInstrumentationData } from "./preInstrument";
+
+// The native addon registers the coverage map of the process with libFuzzer
+// when it is loaded, which the main thread already did. Edge IDs assigned in
+// the worker are replaced when the modules are loaded, so the coverage
+// tracker is not needed here. Instrumented code never runs in the worker,
+// the stub only covers what core and the bug detectors use while they are
+// loaded. Without the native call site IDs, hook IDs are hashed in JS.
+function stubFuzzer() {
+	const noop = () => undefined;
+	const fuzzer = {
+		coverageTracker: {
+			enlargeCountersBufferIfNeeded: noop,
+			incrementCounter: noop,
+			readCounter: () => 0,
+			createModuleCounters: (size: number) => Buffer.alloc(size),
+		},
+		tracer: {
+			traceStrCmp: noop,
+			traceUnequalStrings: noop,
+			traceStringContainment: noop,
+			traceNumberCmp: noop,
+			traceAndReturn: noop,
+			switchCases: noop,
+			traceSwitch: noop,
+			tracePcIndir: noop,
+			guideTowardsEquality: noop,
+			guideTowardsContainment: noop,
+			guideTowardsEqualBytes: noop,
+			guideTowardsBytesContainment: noop,
+			exploreState: noop,
+		},
+		fingerprintPrototypes: () => 0,
+		monitorHeap: noop,
+		recordIterationPhase: noop,
+	};
+	const filename = require.resolve("@jazzer.js/fuzzer");
+	const module = new Module(filename);
+	module.filename = filename;
+	module.loaded = true;
+	module.exports = { fuzzer, IterationPhase: {} };
+	require.cache[filename] = module;
+}
+
+async function instrumentFiles(data: PreInstrumentationData) {
+	stubFuzzer();
+	const { MemorySyncIdStrategy } =
+		require("@jazzer.js/instrumentor") as typeof import("@jazzer.js/instrumentor");
+	const { createInstrumentor, loadBugDetectorsAndHooks, registerGlobals } =
+		require("./core") as typeof import("./core");
+	const { OptionsManager } = require("./options") as typeof import("./options");
+
+	const options = new OptionsManager(data.options);
+	registerGlobals(options);
+	const instrumentor = createInstrumentor(
+		options,
+		data.seed,
+		data.cacheDirectory,
+		new MemorySyncIdStrategy(),
+	);
+	instrumentor.init();
+	await loadBugDetectorsAndHooks(options);
+
+	for (const file of data.files) {
+		let code: string;
+		try {
+			code = fs.readFileSync(file, "utf8");
+		} catch {
+			continue;
+		}
+		instrumentor.instrument(code, file);
+	}
+}
+
+instrumentFiles(workerData as PreInstrumentationData);
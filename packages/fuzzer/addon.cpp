@@ -16,6 +16,7 @@
 
 #include "fuzzing_async.h"
 #include "fuzzing_sync.h"
+#include "profiling.h"
 
 #include "shared/callbacks.h"
 #include "shared/libfuzzer.h"
@@ -61,6 +62,10 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
 
   exports["startFuzzing"] = Napi::Function::New<StartFuzzing>(env);
   exports["startFuzzingAsync"] = Napi::Function::New<StartFuzzingAsync>(env);
+  exports["getIterationProfile"] =
+      Napi::Function::New<profiling::GetIterationProfile>(env);
+  exports["recordIterationPhase"] =
+      Napi::Function::New<profiling::RecordIterationPhase>(env);
 
   RegisterCallbackExports(env, exports);
   return exports;
@@ -27,20 +27,103 @@ export type FuzzTargetCallback = (
 export type FuzzTarget = FuzzTargetAsyncOrValue | FuzzTargetCallback;
 export type FuzzOpts = string[];
 
+/**
+ * Options controlling how the native addon executes the fuzz target.
+ */
+export type ExecutionOptions = {
+	// Pass libFuzzer's input to the fuzz target without copying it. The
+	// buffer is only valid during the invocation and must not be modified.
+	zeroCopyInput: boolean;
+	// Run async iterations back to back on the main thread while they don't
+	// have to wait for the event loop. Only used by `startFuzzingAsync`.
+	inlineAsync: boolean;
+	// Record the duration of the phases of each iteration, see
+	// `getIterationProfile`.
+	profile: boolean;
+	// Directory to write unusually slow inputs to while profiling, if not
+	// empty.
+	slowInputDirectory: string;
+	// Heap growth in megabytes after which a full garbage collection is run
+	// between iterations, or 0 to leave all collections to V8.
+	gcBudget: number;
+};
+
+// The phases of a fuzzer iteration, see `profiling::Phase` in profiling.h.
+export enum IterationPhase {
+	Handoff = 0,
+	Input = 1,
+	BeforeEach = 2,
+	Target = 3,
+	AfterEach = 4,
+	Drain = 5,
+	Gc = 6,
+	ScheduledGc = 7,
+	Total = 8,
+}
+
+// Summary of the recorded durations of an iteration phase, in microseconds.
+export type PhaseProfile = {
+	count: number;
+	mean: number;
+	p50: number;
+	p90: number;
+	p99: number;
+	p999: number;
+	max: number;
+};
+export type IterationProfile = Record<
+	| "handoff"
+	| "input"
+	| "beforeEach"
+	| "target"
+	| "afterEach"
+	| "drain"
+	| "gc"
+	| "scheduledGc"
+	| "total",
+	PhaseProfile
+>;
+
 export type StartFuzzingSyncFn = (
 	fuzzFn: FuzzTarget,
 	fuzzOpts: FuzzOpts,
 	jsStopCallback: (signal: number) => void,
+	executionOptions: ExecutionOptions,
 ) => Promise<void>;
 export type StartFuzzingAsyncFn = (
 	fuzzFn: FuzzTarget,
 	fuzzOpts: FuzzOpts,
+	executionOptions: ExecutionOptions,
 ) => Promise<void>;
 
 type NativeAddon = {
+	createCoverageMap: () => Buffer | undefined;
 	registerCoverageMap: (buffer: Buffer) => void;
-	registerNewCounters: (oldNumCounters: number, newNumCounters: number) => void;
+	registerNewCounters: (
+		oldNumCounters: number,
+		newNumCounters: number,
+	) => number;
 	registerModuleCounters: (buffer: Buffer) => void;
+	allocateModuleCounters: (size: number) => Buffer | undefined;
+	registerCounterSymbols: (
+		counters: Buffer,
+		file: string,
+		functions: string[],
+		locations: Uint32Array,
+		entries: Uint32Array,
+	) => void;
+
+	openEdgeIdTable: (path: string) => number | undefined;
+	claimEdgeIds: (
+		table: number,
+		filename: string,
+	) => [firstId: number, count: number] | null | undefined;
+	commitEdgeIds: (
+		table: number,
+		filename: string,
+		count: number,
+		shared?: boolean,
+	) => number;
 
 	traceUnequalStrings: (
 		hookId: number,
@@ -53,20 +136,56 @@ type NativeAddon = {
 		needle: string,
 		haystack: string,
 	) => void;
+	traceUnequalBytes: (
+		hookId: number,
+		current: ArrayBufferView | ArrayBuffer,
+		target: ArrayBufferView | ArrayBuffer,
+	) => void;
+
+	traceBytesContainment: (
+		hookId: number,
+		needle: ArrayBufferView | ArrayBuffer,
+		haystack: ArrayBufferView | ArrayBuffer,
+	) => void;
 	traceIntegerCompare: (
 		hookId: number,
 		current: number,
 		target: number,
 	) => void;
 
+	registerSwitchCases: (
+		filename: string,
+		site: number,
+		cases: number[],
+	) => number;
+
 	tracePcIndir: (hookId: number, state: number) => void;
 
+	// Only available if the addon was built with V8's C++ API.
+	callSiteId?: (seed?: number) => number;
+	fingerprintPrototypes: (objects: unknown[]) => number;
+	// Only available if the addon was built with V8's C++ API.
+	monitorHeap?: (state: Float64Array) => void;
+
+	registerTraceBuffer: (
+		state: Uint32Array,
+		records: Float64Array,
+		strings: string[],
+		seenEpoch: Uint32Array,
+		seenKind: Uint8Array,
+		seenId: Float64Array,
+		seenOperands: unknown[],
+	) => void;
+	flushTraceBuffer: () => void;
+
 	printAndDumpCrashingInput: () => void;
 	printReturnInfo: (sync: boolean) => void;
 	printVersion: () => void;
 
 	startFuzzing: StartFuzzingSyncFn;
 	startFuzzingAsync: StartFuzzingAsyncFn;
+	getIterationProfile: () => IterationProfile;
+	recordIterationPhase: (phase: IterationPhase, nanoseconds: number) => void;
 };
 
 function addonFilename(): string {
@@ -78,7 +197,18 @@ function addonFilename(): string {
 	} else {
 		throw new Error("Could not find prebuilds directory");
 	}
-	return path.join(dirName, `fuzzer-${process.platform}-${process.arch}.node`);
+	// Builds using V8's C++ API only load into Node versions with the ABI they
+	// were built for, otherwise the build using Node-API only is loaded, which
+	// lacks the features based on V8 (see CMakeLists.txt).
+	const name = `fuzzer-${process.platform}-${process.arch}`;
+	const abiSpecific = path.join(
+		dirName,
+		`${name}-abi${process.versions.modules}.node`,
+	);
+	if (fs.existsSync(abiSpecific)) {
+		return abiSpecific;
+	}
+	return path.join(dirName, `${name}.node`);
 }
 
 export const addon: NativeAddon = require(addonFilename());
@@ -16,44 +16,76 @@
 
 import { addon } from "./addon";
 
+/**
+ * Source locations of the coverage counters of a module as emitted by the
+ * instrumentor: the file, the names of its functions, a (function index,
+ * line, column) triple per counter and the indices of the counters at function
+ * entries.
+ */
+export type CounterSymbols = [
+	file: string,
+	functions: string[],
+	locations: number[],
+	entries: number[],
+];
+
 export class CoverageTracker {
-	private static readonly MAX_NUM_COUNTERS: number = 1 << 20;
+	// Size of the coverage map if it has to be allocated in JavaScript, as the
+	// addon can't reserve address space for it in the current environment.
+	private static readonly FALLBACK_NUM_COUNTERS: number = 1 << 20;
 	private static readonly INITIAL_NUM_COUNTERS: number = 1 << 9;
 	private readonly coverageMap: Buffer;
 	private currentNumCounters: number;
 
-	// Per-module counter buffers registered independently with libFuzzer.
+	// Per-module counter buffers allocated in JavaScript if the module slabs
+	// of the addon can't be used, registered independently with libFuzzer.
 	// We must prevent GC from reclaiming these while libFuzzer still
 	// monitors the underlying memory.
 	private readonly moduleCounters: Buffer[] = [];
+	private useModuleSlabs = true;
 
 	constructor() {
-		this.coverageMap = Buffer.alloc(CoverageTracker.MAX_NUM_COUNTERS, 0);
-		this.currentNumCounters = CoverageTracker.INITIAL_NUM_COUNTERS;
-		addon.registerCoverageMap(this.coverageMap);
-		addon.registerNewCounters(0, this.currentNumCounters);
+		// The native map only reserves address space up front and commits the
+		// pages of newly registered counters, so it can grow far beyond what
+		// would be sensible to allocate eagerly.
+		const nativeMap = addon.createCoverageMap();
+		if (nativeMap) {
+			this.coverageMap = nativeMap;
+		} else {
+			this.coverageMap = Buffer.alloc(
+				CoverageTracker.FALLBACK_NUM_COUNTERS,
+				0,
+			);
+			addon.registerCoverageMap(this.coverageMap);
+		}
+		this.currentNumCounters = addon.registerNewCounters(
+			0,
+			CoverageTracker.INITIAL_NUM_COUNTERS,
+		);
 	}
 
 	enlargeCountersBufferIfNeeded(nextEdgeId: number) {
-		// Enlarge registered counters if needed
+		if (nextEdgeId < this.currentNumCounters) {
+			return;
+		}
+		if (nextEdgeId >= this.coverageMap.length) {
+			throw new Error(
+				`Maximum number (${this.coverageMap.length}) of coverage counts exceeded.`,
+			);
+		}
+
+		// Register new counters, the addon may round up to full pages
 		let newNumCounters = this.currentNumCounters;
 		while (nextEdgeId >= newNumCounters) {
 			newNumCounters = 2 * newNumCounters;
-			if (newNumCounters > CoverageTracker.MAX_NUM_COUNTERS) {
-				throw new Error(
-					`Maximum number (${CoverageTracker.MAX_NUM_COUNTERS}) of coverage counts exceeded.`,
-				);
-			}
-		}
-
-		// Register new counters if enlarged
-		if (newNumCounters > this.currentNumCounters) {
-			addon.registerNewCounters(this.currentNumCounters, newNumCounters);
-			this.currentNumCounters = newNumCounters;
-			console.error(
-				`INFO: New number of coverage counters ${this.currentNumCounters}`,
-			);
 		}
+		this.currentNumCounters = addon.registerNewCounters(
+			this.currentNumCounters,
+			Math.min(newNumCounters, this.coverageMap.length),
+		);
+		console.error(
+			`INFO: New number of coverage counters ${this.currentNumCounters}`,
+		);
 	}
 
 	/**
@@ -63,25 +95,82 @@ export class CoverageTracker {
 	 * @param edgeId the edge ID of the coverage counter to increment
 	 */
 	incrementCounter(edgeId: number) {
+		// Counters beyond the registered ones may not be backed by memory yet.
+		this.enlargeCountersBufferIfNeeded(edgeId);
 		const counter = this.coverageMap.readUint8(edgeId);
 		this.coverageMap.writeUint8(counter == 255 ? 1 : counter + 1, edgeId);
 	}
 
+	/**
+	 * Returns a view of the counters for the given range of edge IDs. CJS
+	 * modules index into this view directly instead of calling
+	 * `incrementCounter` for every edge.
+	 */
+	counterRange(
+		firstEdgeId: number,
+		edgeCount: number,
+		symbols?: CounterSymbols,
+	): Buffer {
+		// Counters beyond the registered ones may not be backed by memory yet.
+		if (edgeCount > 0) {
+			this.enlargeCountersBufferIfNeeded(firstEdgeId + edgeCount - 1);
+		}
+		const counters = this.coverageMap.subarray(
+			firstEdgeId,
+			firstEdgeId + edgeCount,
+		);
+		if (symbols) {
+			this.registerSymbols(counters, symbols);
+		}
+		return counters;
+	}
+
 	readCounter(edgeId: number): number {
+		// Counters that were never registered can't have been incremented, and
+		// may not be backed by memory.
+		if (edgeId >= this.currentNumCounters && edgeId < this.coverageMap.length) {
+			return 0;
+		}
 		return this.coverageMap.readUint8(edgeId);
 	}
 
 	/**
-	 * Allocate an independent counter buffer for a single module and
-	 * register it with libFuzzer as a new coverage region.  This lets
-	 * each ESM module own its own counters without sharing global IDs.
+	 * Allocate the counters of a single ES module.  This lets each ESM
+	 * module own its own counters without sharing global IDs.  The addon
+	 * carves them out of large slabs registered with libFuzzer as a whole;
+	 * if it can't, e.g. in Electron, every module gets its own buffer,
+	 * registered with libFuzzer as a new coverage region.
 	 */
-	createModuleCounters(size: number): Buffer {
-		const buf = Buffer.alloc(size, 0);
-		this.moduleCounters.push(buf);
-		addon.registerModuleCounters(buf);
+	createModuleCounters(size: number, symbols?: CounterSymbols): Buffer {
+		let buf = this.useModuleSlabs
+			? addon.allocateModuleCounters(size)
+			: undefined;
+		if (!buf) {
+			this.useModuleSlabs = false;
+			buf = Buffer.alloc(size, 0);
+			this.moduleCounters.push(buf);
+			addon.registerModuleCounters(buf);
+		}
+		if (symbols) {
+			this.registerSymbols(buf, symbols);
+		}
 		return buf;
 	}
+
+	/**
+	 * Pass the source locations of the given counters on to the addon, which
+	 * uses them to symbolize the counters in libFuzzer's output.
+	 */
+	private registerSymbols(counters: Buffer, symbols: CounterSymbols) {
+		const [file, functions, locations, entries] = symbols;
+		addon.registerCounterSymbols(
+			counters,
+			file,
+			functions,
+			Uint32Array.from(locations),
+			Uint32Array.from(entries),
+		);
+	}
 }
 
 export const coverageTracker = new CoverageTracker();
@@ -0,0 +1,100 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#ifdef _WIN32
+#include <process.h>
+#define GetPID _getpid
+#else
+#include <unistd.h>
+#define GetPID getpid
+#endif
+
+#include "fuzz_input.h"
+#include "shared/libfuzzer.h"
+
+// Node-API only declares napi_detach_arraybuffer starting with version 7, but
+// we build against version 4 (see CMakeLists.txt). The function is exported by
+// every Node.js version supporting Node-API 7, so we declare it ourselves and
+// only call it after checking the version at runtime.
+extern "C" NAPI_EXTERN napi_status
+napi_detach_arraybuffer(napi_env env, napi_value arraybuffer);
+
+FuzzInput::FuzzInput(Napi::Env env, const uint8_t *data, size_t size,
+                     bool zero_copy)
+    : env_(env), data_(data), size_(size), value_(nullptr), head_(), tail_() {
+  // Empty inputs are cheap to copy and not worth the bookkeeping.
+  if (!zero_copy || size == 0) {
+    value_ = Napi::Buffer<uint8_t>::Copy(env, data, size);
+    return;
+  }
+
+  // libFuzzer owns the memory and frees it after the iteration, hence the
+  // buffer is created without a finalizer.
+  auto buffer =
+      Napi::Buffer<uint8_t>::New(env, const_cast<uint8_t *>(data), size);
+  zero_copy_buffer_ = Napi::Persistent(buffer);
+  value_ = buffer;
+
+  auto guard_size = std::min(size, kGuardSize);
+  std::memcpy(head_.data(), data, guard_size);
+  std::memcpy(tail_.data(), data + size - guard_size, guard_size);
+}
+
+FuzzInput::~FuzzInput() { Release(); }
+
+Napi::Value FuzzInput::Value() const { return Napi::Value(env_, value_); }
+
+void FuzzInput::Release() {
+  if (zero_copy_buffer_.IsEmpty()) {
+    return;
+  }
+
+  auto array_buffer = zero_copy_buffer_.Value().ArrayBuffer();
+  zero_copy_buffer_.Reset();
+  if (napi_detach_arraybuffer(env_, array_buffer) != napi_ok) {
+    Napi::Error::Fatal("FuzzInput::Release",
+                       "napi_detach_arraybuffer() failed");
+  }
+
+  // The input is only valid as long as the iteration runs, and writing to it
+  // would change libFuzzer's view of the executed input. Treat modifications
+  // as a finding, so that they are fixed in the fuzz target.
+  auto guard_size = std::min(size_, kGuardSize);
+  if (std::memcmp(head_.data(), data_, guard_size) != 0 ||
+      std::memcmp(tail_.data(), data_ + size_ - guard_size, guard_size) !=
+          0) {
+    std::cerr << "==" << (unsigned long)GetPID()
+              << "== Jazzer.js: Fuzz target modified its input. The input "
+                 "buffer is shared with the fuzzer when using zero-copy input "
+                 "and must not be written to, copy it first if needed."
+              << std::endl;
+    libfuzzer::PrintCrashingInput();
+    _Exit(libfuzzer::EXIT_ERROR_CODE);
+  }
+}
+
+bool IsZeroCopyInputSupported(Napi::Env env) {
+  if (Napi::VersionManagement::GetNapiVersion(env) < 7) {
+    return false;
+  }
+  // Some embedders, e.g. Electron, don't allow external buffers at all.
+  static uint8_t probe = 0;
+  napi_value buffer;
+  return napi_create_external_buffer(env, 1, &probe, nullptr, nullptr,
+                                     &buffer) == napi_ok;
+}
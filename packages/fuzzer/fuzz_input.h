@@ -0,0 +1,66 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <napi.h>
+
+// The fuzzer-generated input handed to the JS fuzz target in one iteration.
+//
+// By default, the input is copied into a fresh Node.js Buffer. In zero-copy
+// mode, the Buffer is backed directly by libFuzzer's memory instead, which
+// saves an allocation, a copy and the external memory accounting of a
+// GC-tracked Buffer per iteration. libFuzzer frees that memory as soon as the
+// iteration is done, so `Release` detaches the Buffer's ArrayBuffer and the
+// target can not access stale memory by holding on to the Buffer.
+class FuzzInput {
+public:
+  FuzzInput(Napi::Env env, const uint8_t *data, size_t size, bool zero_copy);
+  ~FuzzInput();
+
+  FuzzInput(const FuzzInput &) = delete;
+  FuzzInput &operator=(const FuzzInput &) = delete;
+
+  // The Buffer to pass to the fuzz target. Only valid in the handle scope in
+  // which the input was created.
+  Napi::Value Value() const;
+
+  // Detach a zero-copy Buffer and make sure the fuzz target did not write to
+  // libFuzzer's input. Has to be called on the JS thread once the fuzz target
+  // is done with the input, and at the latest when the input is destroyed.
+  void Release();
+
+private:
+  // Number of bytes at the start and the end of the input that are checked for
+  // modifications. Like libFuzzer's own check, this keeps the cost of the
+  // check independent of the input size.
+  static constexpr size_t kGuardSize = 64;
+
+  Napi::Env env_;
+  const uint8_t *data_;
+  size_t size_;
+  napi_value value_;
+  Napi::Reference<Napi::Buffer<uint8_t>> zero_copy_buffer_;
+  std::array<uint8_t, kGuardSize> head_;
+  std::array<uint8_t, kGuardSize> tail_;
+};
+
+// Check if the running Node.js version supports zero-copy fuzzer input. This
+// requires detachable external buffers, which are not available in all
+// environments, e.g. in Electron.
+bool IsZeroCopyInputSupported(Napi::Env env);
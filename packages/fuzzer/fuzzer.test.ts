@@ -14,7 +14,7 @@
  * limitations under the License.
  */
 
-import { fuzzer } from "./fuzzer";
+import { fuzzer, IterationPhase } from "./fuzzer";
 
 describe("compare hooks", () => {
 	it("traceStrCmp supports equals operators", () => {
@@ -50,3 +50,135 @@ describe("incrementCounter", () => {
 		}
 	});
 });
+
+describe("coverage map", () => {
+	it("grows beyond a million counters", () => {
+		const edgeId = (1 << 21) + 3;
+		const counters = fuzzer.coverageTracker.counterRange(edgeId, 1);
+		counters[0] = 7;
+		expect(fuzzer.coverageTracker.readCounter(edgeId)).toBe(7);
+	});
+
+	it("registers counters before accessing them by edge ID", () => {
+		const edgeId = (1 << 22) + 5;
+		expect(fuzzer.coverageTracker.readCounter(edgeId)).toBe(0);
+		fuzzer.coverageTracker.incrementCounter(edgeId);
+		expect(fuzzer.coverageTracker.readCounter(edgeId)).toBe(1);
+		expect(() => fuzzer.coverageTracker.readCounter(-1)).toThrow(RangeError);
+	});
+});
+
+describe("module counters", () => {
+	it("are separate for each module", () => {
+		const first = fuzzer.coverageTracker.createModuleCounters(3);
+		const second = fuzzer.coverageTracker.createModuleCounters(5);
+		expect(first.length).toBe(3);
+		expect(second.length).toBe(5);
+		first.fill(1);
+		expect(second.every((counter) => counter === 0)).toBe(true);
+	});
+
+	it("may be larger than a slab", () => {
+		const counters = fuzzer.coverageTracker.createModuleCounters(1 << 17);
+		counters[counters.length - 1] = 1;
+		expect(counters[counters.length - 1]).toBe(1);
+	});
+});
+
+describe("counter symbols", () => {
+	it("are registered together with the counters", () => {
+		const counters = fuzzer.coverageTracker.counterRange(8, 2, [
+			"module.js",
+			["<top-level>", "foo"],
+			[0, 1, 1, 1, 2, 5],
+			[1],
+		]);
+		expect(counters.length).toBe(2);
+		const moduleCounters = fuzzer.coverageTracker.createModuleCounters(1, [
+			"module.mjs",
+			[],
+			[0, 0, 0],
+			[],
+		]);
+		expect(moduleCounters.length).toBe(1);
+	});
+
+	it("require one location per counter", () => {
+		expect(() =>
+			fuzzer.coverageTracker.counterRange(8, 2, [
+				"module.js",
+				["foo"],
+				[0, 1, 1],
+				[0],
+			]),
+		).toThrow();
+	});
+});
+
+describe("trace buffer", () => {
+	it("records more compare events than fit into the buffer", () => {
+		for (let i = 0; i < 10000; i++) {
+			expect(fuzzer.tracer.traceNumberCmp(i, i + 1, "<", i)).toBe(true);
+			expect(fuzzer.tracer.traceStrCmp(`a${i}`, "b", "===", i)).toBe(false);
+		}
+	});
+
+	it("records float, BigInt and switch events", () => {
+		const table = fuzzer.tracer.switchCases("fuzzer", 0, [-1, 2, 0x89504e47]);
+		for (let i = 0; i < 10000; i++) {
+			expect(fuzzer.tracer.traceNumberCmp(i + 0.5, 1.5, "==", i)).toBe(false);
+			expect(fuzzer.tracer.traceNumberCmp(BigInt(i), 2n ** 64n, "<", i)).toBe(
+				true,
+			);
+			expect(fuzzer.tracer.traceSwitch(i, table, i)).toBe(i);
+		}
+	});
+
+	it("skips repeated compare events", () => {
+		for (let i = 0; i < 10000; i++) {
+			expect(fuzzer.tracer.traceNumberCmp(1, 2, "==", 42)).toBe(false);
+			expect(fuzzer.tracer.traceStrCmp("a", "b", "==", 42)).toBe(false);
+		}
+	});
+});
+
+describe("prototype fingerprint", () => {
+	it("changes with every replaced property value", () => {
+		class Watched {
+			method() {
+				return 1;
+			}
+		}
+		const objects = [new Watched()];
+		const initial = fuzzer.fingerprintPrototypes(objects);
+		expect(fuzzer.fingerprintPrototypes(objects)).toBe(initial);
+
+		Watched.prototype.method = () => 2;
+		const replaced = fuzzer.fingerprintPrototypes(objects);
+		expect(replaced).not.toBe(initial);
+		expect(fuzzer.fingerprintPrototypes(objects)).toBe(replaced);
+
+		Watched.prototype.method = () => 3;
+		expect(fuzzer.fingerprintPrototypes(objects)).not.toBe(replaced);
+	});
+});
+
+describe("iteration profile", () => {
+	it("summarizes the recorded durations of a phase", () => {
+		for (let i = 1; i <= 100; i++) {
+			fuzzer.recordIterationPhase(IterationPhase.AfterEach, i * 1000);
+		}
+		const profile = fuzzer.getIterationProfile().afterEach;
+		expect(profile.count).toBe(100);
+		expect(profile.mean).toBeCloseTo(50.5);
+		// Percentiles are precise up to the width of the histogram buckets.
+		expect(profile.p50).toBeCloseTo(50, 0);
+		expect(profile.max).toBe(100);
+	});
+
+	it("rejects unknown phases", () => {
+		expect(() =>
+			fuzzer.recordIterationPhase(42 as IterationPhase, 1000),
+		).toThrow();
+	});
+});
@@ -19,16 +19,28 @@ import { CoverageTracker, coverageTracker } from "./coverage";
 import { Tracer, tracer } from "./trace";
 
 export type {
+	ExecutionOptions,
 	FuzzTarget,
 	FuzzTargetAsyncOrValue,
 	FuzzTargetCallback,
+	IterationProfile,
+	PhaseProfile,
 } from "./addon";
+export { IterationPhase } from "./addon";
 
 export interface Fuzzer {
 	coverageTracker: CoverageTracker;
 	tracer: Tracer;
+	openEdgeIdTable: typeof addon.openEdgeIdTable;
+	claimEdgeIds: typeof addon.claimEdgeIds;
+	commitEdgeIds: typeof addon.commitEdgeIds;
+	callSiteId: typeof addon.callSiteId;
+	fingerprintPrototypes: typeof addon.fingerprintPrototypes;
+	monitorHeap: typeof addon.monitorHeap;
 	startFuzzing: typeof addon.startFuzzing;
 	startFuzzingAsync: typeof addon.startFuzzingAsync;
+	getIterationProfile: typeof addon.getIterationProfile;
+	recordIterationPhase: typeof addon.recordIterationPhase;
 	printAndDumpCrashingInput: typeof addon.printAndDumpCrashingInput;
 	printReturnInfo: typeof addon.printReturnInfo;
 }
@@ -36,8 +48,16 @@ export interface Fuzzer {
 export const fuzzer: Fuzzer = {
 	coverageTracker: coverageTracker,
 	tracer: tracer,
+	openEdgeIdTable: addon.openEdgeIdTable,
+	claimEdgeIds: addon.claimEdgeIds,
+	commitEdgeIds: addon.commitEdgeIds,
+	callSiteId: addon.callSiteId,
+	fingerprintPrototypes: addon.fingerprintPrototypes,
+	monitorHeap: addon.monitorHeap,
 	startFuzzing: addon.startFuzzing,
 	startFuzzingAsync: addon.startFuzzingAsync,
+	getIterationProfile: addon.getIterationProfile,
+	recordIterationPhase: addon.recordIterationPhase,
 	printAndDumpCrashingInput: addon.printAndDumpCrashingInput,
 	printReturnInfo: addon.printReturnInfo,
 };
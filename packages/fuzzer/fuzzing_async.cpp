@@ -13,11 +13,16 @@
 //  limitations under the License.
 
 #include "napi.h"
+#include <atomic>
+#include <climits>
+#include <condition_variable>
 #include <csetjmp>
 #include <csignal>
 #include <cstdlib>
-#include <future>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #ifdef _WIN32
 #include <process.h>
@@ -27,39 +32,172 @@
 #define GetPID getpid
 #endif
 
+#include "fuzz_input.h"
 #include "fuzzing_async.h"
+#include "gc_scheduler.h"
+#include "profiling.h"
 #include "shared/libfuzzer.h"
+#include "shared/tracing.h"
 #include "utils.h"
 
 namespace {
 
+// Hands the result of an iteration from the JS thread over to the waiting
+// libFuzzer thread. In contrast to a std::promise, it's reused for all
+// iterations and does not allocate. As most fuzz targets return quickly, the
+// libFuzzer thread spins for a short while before it blocks, and the JS thread
+// only has to notify it in the latter case.
+class IterationResult {
+public:
+  // Result marking that the JS environment was shut down.
+  static constexpr int kShutdown = INT_MIN + 1;
+
+  // Prepare for the next iteration, called by the libFuzzer thread before the
+  // iteration is handed over to the JS thread.
+  void Reset() { result_.store(kPending, std::memory_order_relaxed); }
+
+  // Publish the result of the iteration, called by the JS thread.
+  void Set(int result) {
+    result_.store(result);
+    if (waiting_.load()) {
+      // Taking the lock makes sure that the waiting thread either already
+      // sleeps or still has to check the result.
+      std::lock_guard<std::mutex> lock(mutex_);
+      condition_.notify_one();
+    }
+  }
+
+  // Wait for the result of the iteration, called by the libFuzzer thread.
+  int Wait() {
+    for (int i = 0; i < kSpinIterations; ++i) {
+      auto result = result_.load(std::memory_order_acquire);
+      if (result != kPending) {
+        return result;
+      }
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_.store(true);
+    condition_.wait(lock, [this] { return result_.load() != kPending; });
+    waiting_.store(false);
+    return result_.load();
+  }
+
+private:
+  static constexpr int kPending = INT_MIN;
+  static constexpr int kSpinIterations = 1 << 10;
+
+  std::atomic<int> result_{kPending};
+  std::atomic<bool> waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+// The data type to use each time we schedule a call to the JavaScript fuzz
+// target, i.e. the fuzzer-generated input. The result of the JS fuzz target is
+// passed back via the context's IterationResult and controls if the fuzzer
+// loop should continue or stop.
+struct DataType {
+  const uint8_t *data;
+  size_t size;
+  // Started by the libFuzzer thread when profiling.
+  profiling::Stopwatch stopwatch;
+};
+
+// Hands the next input from the libFuzzer thread directly over to the JS
+// thread in inline mode, without a detour via the event loop. The JS thread
+// announces that it will wait for the next input before it passes on the
+// result of the current iteration, so that libFuzzer knows whether to use the
+// thread-safe function instead.
+class InputHandoff {
+public:
+  // Announce that the JS thread will take the next input.
+  void Expect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expected_ = true;
+  }
+
+  // Pass the input on to the JS thread, if it announced to take it. Called by
+  // the libFuzzer thread, returns false if the input has to be scheduled via
+  // the thread-safe function.
+  bool Offer(DataType *input) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!expected_) {
+      return false;
+    }
+    expected_ = false;
+    input_ = input;
+    condition_.notify_one();
+    return true;
+  }
+
+  // Signal that no more inputs will follow, called by the libFuzzer thread
+  // once it's done.
+  void Finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+    condition_.notify_one();
+  }
+
+  // Wait for the announced input, called by the JS thread. Returns nullptr if
+  // libFuzzer finished in the meantime.
+  DataType *Take() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return input_ != nullptr || finished_; });
+    auto *input = input_;
+    input_ = nullptr;
+    return input;
+  }
+
+private:
+  DataType *input_ = nullptr;
+  bool expected_ = false;
+  bool finished_ = false;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
 // The context of the typed thread-safe function we use to call the JavaScript
 // fuzz target.
 struct AsyncFuzzTargetContext {
-  explicit AsyncFuzzTargetContext(Napi::Env env)
-      : deferred(Napi::Promise::Deferred::New(env)){};
+  AsyncFuzzTargetContext(Napi::Env env, ExecutionOptions options)
+      : env(env), deferred(Napi::Promise::Deferred::New(env)),
+        options(options){};
+  Napi::Env env;
   std::thread native_thread;
   Napi::Promise::Deferred deferred;
+  ExecutionOptions options;
+  // The fuzz target, used to run iterations directly in inline mode.
+  Napi::FunctionReference target;
+  // Number of declared parameters of the fuzz target, a second one is the
+  // done callback.
+  int parameter_count = 1;
+  // Callbacks passed to the fuzz target or to the promise it returned. They
+  // only refer to the context, hence are created once and reused in all
+  // iterations.
+  Napi::FunctionReference done;
+  Napi::FunctionReference resolve;
+  Napi::FunctionReference reject;
+  // The input of the currently running iteration.
+  std::optional<FuzzInput> input;
+  // Measures the phases of the currently running iteration when profiling.
+  profiling::Stopwatch stopwatch;
+  IterationResult result;
+  InputHandoff next_input;
+  // Set if the JS thread announced to take the next input in inline mode.
+  bool continue_inline = false;
+  // Set while the fuzz target is called, e.g. to detect synchronous
+  // invocations of the done callback.
+  bool in_call = false;
   bool is_resolved = false;
   bool is_done_called = false;
   AsyncFuzzTargetContext() = delete;
 };
 
-// The data type to use each time we schedule a call to the JavaScript fuzz
-// target. It includes the fuzzer-generated input and a promise to await the
-// execution of the JS fuzz target. The value with which the promise is
-// resolved is forwarded to the fuzzer loop and controls if it should continue
-// or stop.
-struct DataType {
-  const uint8_t *data;
-  size_t size;
-  std::promise<int> *promise;
-
-  DataType() = delete;
-};
-
 void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
                         AsyncFuzzTargetContext *context, DataType *data);
+void ContinueInline(Napi::Env env, AsyncFuzzTargetContext *context);
 using TSFN = Napi::TypedThreadSafeFunction<AsyncFuzzTargetContext, DataType,
                                            CallJsFuzzCallback>;
 using FinalizerDataType = void;
@@ -92,46 +230,136 @@ void ErrorSignalHandler(int signum) { std::longjmp(executionContext, signum); }
 // environment and thus can only call the JavaScript fuzz target via the
 // typed thread-safe function.
 int FuzzCallbackAsync(const uint8_t *Data, size_t Size) {
-  // Pass a promise to the addon part executed in the JavaScript context
-  // via the data object of the typed thread-safe function. Await it's
-  // resolution or rejection to continue fuzzing.
-  std::promise<int> promise;
-  auto input = DataType{Data, Size, &promise};
-
-  auto future = promise.get_future();
-  auto status = gTSFN.BlockingCall(&input);
-  if (status != napi_ok) {
-    Napi::Error::Fatal("FuzzCallbackAsync",
-                       "Napi::TypedThreadSafeFunction.BlockingCall() failed");
+  // Pass the input to the addon part executed in the JavaScript context via
+  // the data object of the typed thread-safe function. Await the result of the
+  // iteration to continue fuzzing.
+  auto *context = gTSFN.GetContext();
+  auto stopwatch = profiling::Stopwatch::Start();
+  auto input = DataType{Data, Size, stopwatch};
+
+  context->result.Reset();
+  if (!context->options.inline_async || !context->next_input.Offer(&input)) {
+    auto status = gTSFN.BlockingCall(&input);
+    if (status != napi_ok) {
+      Napi::Error::Fatal("FuzzCallbackAsync",
+                         "Napi::TypedThreadSafeFunction.BlockingCall() failed");
+    }
   }
-  try {
-    // Await the return of the JavaScript fuzz target with
-    // libfuzzer::RETURN_EXIT or libfuzzer::RETURN_CONTINUE.
-    return future.get();
-  } catch (std::exception &exception) {
+
+  // Await the return of the JavaScript fuzz target with
+  // libfuzzer::RETURN_EXIT or libfuzzer::RETURN_CONTINUE.
+  auto result = context->result.Wait();
+  if (result == IterationResult::kShutdown) {
     // Something in the interop did not work. Just call exit to immediately
     // terminate the process without performing any cleanup including libFuzzer
     // exit handlers.
     std::cerr << "==" << (unsigned long)GetPID()
-              << "== Jazzer.js: Unexpected Error: " << exception.what()
+              << "== Jazzer.js: Unexpected Error: Environment is shut down"
               << std::endl;
     libfuzzer::PrintCrashingInput();
     _Exit(libfuzzer::EXIT_ERROR_CODE);
   }
+  if (stopwatch.IsRunning()) {
+    profiling::RecordIteration(Data, Size, stopwatch.Elapsed());
+  }
+  return result;
 }
 
-// This function is the callback that gets executed in the addon's main thread
-// (i.e., the JavaScript event loop thread) and thus we can call the JavaScript
-// code and use the Node API to create JavaScript objects.
-void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
-                        AsyncFuzzTargetContext *context, DataType *data) {
+// Finish the current iteration by releasing its input and passing the result
+// on to the waiting libFuzzer thread. The input has to be released and the
+// recorded compare events passed on first, as libFuzzer frees the underlying
+// memory and stops accepting compare events as soon as it continues.
+void CompleteIteration(AsyncFuzzTargetContext *context, int result) {
+  context->stopwatch.Lap(profiling::Phase::kTarget);
+  context->input.reset();
+  DrainTraceBuffer(context->env, true);
+  context->stopwatch.Lap(profiling::Phase::kDrain);
+  context->stopwatch.Stop();
+  // In inline mode, the JS thread directly continues with the next input
+  // instead of returning to the event loop. This has to be announced before
+  // libFuzzer continues, see InputHandoff.
+  if (context->options.inline_async &&
+      result == libfuzzer::RETURN_CONTINUE) {
+    context->next_input.Expect();
+    context->continue_inline = true;
+  }
+  context->result.Set(result);
+}
+
+// Create the callbacks passed to the fuzz target and its returned promises.
+void CreateCallbacks(Napi::Env env, AsyncFuzzTargetContext *context) {
+  context->done = Napi::Persistent(Napi::Function::New<>(
+      env, [context](const Napi::CallbackInfo &info) {
+        // If the done callback based fuzz target also returned a promise,
+        // is_resolved could been set and there's nothing to do anymore.
+        // As the done callback is executed on the main event loop, no
+        // synchronization for is_resolved is needed.
+        if (context->is_resolved) {
+          return;
+        }
+
+        // Raise an error if the done callback is called multiple times.
+        if (context->is_done_called) {
+          context->deferred.Reject(
+              Napi::Error::New(info.Env(), "Expected done to be called once, "
+                                           "but it was called multiple times.")
+                  .Value());
+          context->is_resolved = true;
+          // Can not break out of the fuzzer loop, as the promise was
+          // already resolved in the last invocation of the done
+          // callback. Probably the best thing to do is print an error
+          // message and await the timeout.
+          std::cerr << "Expected done to be called once, but it was "
+                       "called multiple times."
+                    << std::endl;
+          return;
+        }
+
+        // Mark if the done callback is invoked, to be able to check for
+        // wrongly returned promises and multiple invocations.
+        context->is_done_called = true;
+
+        auto hasError = !(info[0].IsNull() || info[0].IsUndefined());
+        if (hasError) {
+          CompleteIteration(context, libfuzzer::RETURN_EXIT);
+          context->deferred.Reject(info[0].As<Napi::Error>().Value());
+          context->is_resolved = true;
+        } else {
+          CompleteIteration(context, libfuzzer::RETURN_CONTINUE);
+          // A synchronous invocation is continued after the fuzz target
+          // returned.
+          if (!context->in_call) {
+            ContinueInline(info.Env(), context);
+          }
+        }
+      }));
+  context->resolve = Napi::Persistent(Napi::Function::New<>(
+      env, [context](const Napi::CallbackInfo &info) {
+        CompleteIteration(context, libfuzzer::RETURN_CONTINUE);
+        ContinueInline(info.Env(), context);
+      }));
+  context->reject = Napi::Persistent(Napi::Function::New<>(
+      env, [context](const Napi::CallbackInfo &info) {
+        // This is the only way to pass an exception from JavaScript
+        // through C++ back to calling JavaScript code.
+        CompleteIteration(context, libfuzzer::RETURN_EXIT);
+        context->deferred.Reject(info[0].As<Napi::Error>().Value());
+        context->is_resolved = true;
+      }));
+}
+
+// Execute the fuzz target with the given input. The iteration either completes
+// directly, or once the promise returned by the fuzz target settles or the
+// done callback is invoked.
+void RunIteration(Napi::Env env, Napi::Function jsFuzzCallback,
+                  AsyncFuzzTargetContext *context, DataType *data) {
   // Execute the fuzz target and reject the deferred on any raised exception by
   // C++ code or returned error by JS interop to stop fuzzing.
   try {
 
     // Pressing CTRL+C will gracefully end the fuzzing.
     if (nSigInts > 0) {
-      data->promise->set_value(libfuzzer::RETURN_EXIT);
+      CompleteIteration(context, libfuzzer::RETURN_EXIT);
       context->deferred.Resolve(env.Undefined());
       context->is_resolved = true;
       return;
@@ -148,58 +376,24 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
       _Exit(libfuzzer::EXIT_ERROR_SEGV);
     }
     if (env != nullptr) {
-      auto buffer = Napi::Buffer<uint8_t>::Copy(env, data->data, data->size);
+      context->stopwatch = data->stopwatch;
+      context->stopwatch.Lap(profiling::Phase::kHandoff);
+      // A scheduled garbage collection is recorded as a phase of its own.
+      gc_scheduler::CollectIfDue();
+      context->stopwatch.Restart();
+      context->input.emplace(env, data->data, data->size,
+                             context->options.zero_copy_input);
+      context->stopwatch.Lap(profiling::Phase::kInput);
+      auto buffer = context->input->Value();
 
-      auto parameterCount = jsFuzzCallback.As<Napi::Object>()
-                                .Get("length")
-                                .As<Napi::Number>()
-                                .Int32Value();
       // In case more than one parameter is expected, the second one is
       // considered to be a done callback to indicate finished execution.
-      if (parameterCount > 1) {
+      if (context->parameter_count > 1) {
         context->is_done_called = false;
         context->is_resolved = false;
-        auto done =
-            Napi::Function::New<>(env, [=](const Napi::CallbackInfo &info) {
-              // If the done callback based fuzz target also returned a promise,
-              // is_resolved could been set and there's nothing to do anymore.
-              // As the done callback is executed on the main event loop, no
-              // synchronization for is_resolved is needed.
-              if (context->is_resolved) {
-                return;
-              }
-
-              // Raise an error if the done callback is called multiple times.
-              if (context->is_done_called) {
-                context->deferred.Reject(
-                    Napi::Error::New(env, "Expected done to be called once, "
-                                          "but it was called multiple times.")
-                        .Value());
-                context->is_resolved = true;
-                // Can not break out of the fuzzer loop, as the promise was
-                // already resolved in the last invocation of the done
-                // callback. Probably the best thing to do is print an error
-                // message and await the timeout.
-                std::cerr << "Expected done to be called once, but it was "
-                             "called multiple times."
-                          << std::endl;
-                return;
-              }
-
-              // Mark if the done callback is invoked, to be able to check for
-              // wrongly returned promises and multiple invocations.
-              context->is_done_called = true;
-
-              auto hasError = !(info[0].IsNull() || info[0].IsUndefined());
-              if (hasError) {
-                data->promise->set_value(libfuzzer::RETURN_EXIT);
-                context->deferred.Reject(info[0].As<Napi::Error>().Value());
-                context->is_resolved = true;
-              } else {
-                data->promise->set_value(libfuzzer::RETURN_CONTINUE);
-              }
-            });
-        auto result = jsFuzzCallback.Call({buffer, done});
+        context->in_call = true;
+        auto result = jsFuzzCallback.Call({buffer, context->done.Value()});
+        context->in_call = false;
         if (result.IsPromise()) {
           // If the fuzz target received a done callback, but also returned a
           // promise, the callback could already have been called. In that case
@@ -213,7 +407,7 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
             return;
           }
           if (!context->is_done_called) {
-            data->promise->set_value(libfuzzer::RETURN_EXIT);
+            CompleteIteration(context, libfuzzer::RETURN_EXIT);
           }
           context->deferred.Reject(
               Napi::Error::New(env, "Internal fuzzer error - Either async or "
@@ -226,7 +420,9 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
         return;
       }
 
+      context->in_call = true;
       auto result = jsFuzzCallback.Call({buffer});
+      context->in_call = false;
 
       // Register callbacks on returned promise to await its resolution before
       // resolving the fuzzer promise and continue fuzzing. Otherwise, resolve
@@ -235,38 +431,27 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
         AsyncReturnsHandler();
         auto jsPromise = result.As<Napi::Object>();
         auto then = jsPromise.Get("then").As<Napi::Function>();
-        then.Call(
-            jsPromise,
-            {Napi::Function::New<>(env,
-                                   [=](const Napi::CallbackInfo &info) {
-                                     data->promise->set_value(
-                                         libfuzzer::RETURN_CONTINUE);
-                                   }),
-             Napi::Function::New<>(env, [=](const Napi::CallbackInfo &info) {
-               // This is the only way to pass an exception from JavaScript
-               // through C++ back to calling JavaScript code.
-               data->promise->set_value(libfuzzer::RETURN_EXIT);
-               context->deferred.Reject(info[0].As<Napi::Error>().Value());
-               context->is_resolved = true;
-             })});
+        then.Call(jsPromise,
+                  {context->resolve.Value(), context->reject.Value()});
       } else {
         SyncReturnsHandler();
-        data->promise->set_value(libfuzzer::RETURN_CONTINUE);
+        CompleteIteration(context, libfuzzer::RETURN_CONTINUE);
       }
     } else {
-      data->promise->set_exception(std::make_exception_ptr(
-          std::runtime_error("Environment is shut down")));
+      context->result.Set(IterationResult::kShutdown);
     }
   } catch (const Napi::Error &error) {
     // JS exception thrown by invocation of the fuzz target. This is an
     // unhandled exception in the tested code or a finding of a bug detector.
+    context->in_call = false;
     if (context->is_resolved)
       return;
-    data->promise->set_value(libfuzzer::RETURN_EXIT);
+    CompleteIteration(context, libfuzzer::RETURN_EXIT);
     context->deferred.Reject(error.Value());
     context->is_resolved = true;
   } catch (const std::exception &exception) {
-    data->promise->set_value(libfuzzer::RETURN_EXIT);
+    context->in_call = false;
+    CompleteIteration(context, libfuzzer::RETURN_EXIT);
     auto message =
         std::string("Internal fuzzer error - ").append(exception.what());
     context->deferred.Reject(Napi::Error::New(env, message).Value());
@@ -274,6 +459,33 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
   }
 }
 
+// In inline mode, keep running iterations directly on the JS thread as long as
+// they complete without having to return to the event loop, i.e. the fuzz
+// target returns synchronously or its promise settles in the current microtask
+// checkpoint. Iterations awaiting e.g. I/O return to the event loop and are
+// continued from their completion callback.
+void ContinueInline(Napi::Env env, AsyncFuzzTargetContext *context) {
+  while (context->continue_inline) {
+    context->continue_inline = false;
+    auto *data = context->next_input.Take();
+    if (data == nullptr) {
+      return;
+    }
+    // See FuzzCallbackSync for why each iteration needs its own scope.
+    auto scope = Napi::HandleScope(env);
+    RunIteration(env, context->target.Value(), context, data);
+  }
+}
+
+// This function is the callback that gets executed in the addon's main thread
+// (i.e., the JavaScript event loop thread) and thus we can call the JavaScript
+// code and use the Node API to create JavaScript objects.
+void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
+                        AsyncFuzzTargetContext *context, DataType *data) {
+  RunIteration(env, jsFuzzCallback, context, data);
+  ContinueInline(env, context);
+}
+
 } // namespace
 
 // Start libfuzzer with a JS fuzz target asynchronously.
@@ -282,32 +494,44 @@ void CallJsFuzzCallback(Napi::Env env, Napi::Function jsFuzzCallback,
 // in the compiler-rt source). It takes the fuzz target, which must be a JS
 // function taking a single data argument, as its first parameter; the fuzz
 // target's return value is ignored. The second argument is an array of
-// (command-line) arguments to pass to libfuzzer.
+// (command-line) arguments to pass to libfuzzer, the third one an object with
+// execution options.
 //
 // In order not to block JavaScript event loop, we start libfuzzer in a separate
 // thread and use a typed thread-safe function to manage calls to the JavaScript
-// fuzz target which can only happen in the addon's main thread. This function
-// returns a promise so that the JavaScript code can use `catch()` to check when
-// the promise is rejected.
+// fuzz target which can only happen in the addon's main thread. In inline mode,
+// iterations that complete without waiting for the event loop are directly
+// followed by the next one on the main thread, see ContinueInline. This
+// function returns a promise so that the JavaScript code can use `catch()` to
+// check when the promise is rejected.
 Napi::Value StartFuzzingAsync(const Napi::CallbackInfo &info) {
-  if (info.Length() != 2 || !info[0].IsFunction() || !info[1].IsArray()) {
+  if (info.Length() != 3 || !info[0].IsFunction() || !info[1].IsArray() ||
+      !info[2].IsObject()) {
     throw Napi::Error::New(info.Env(),
-                           "Need two arguments, which must be the fuzz target "
-                           "function and an array of libfuzzer arguments");
+                           "Need three arguments, which must be the fuzz "
+                           "target function, an array of libfuzzer arguments "
+                           "and an object with execution options");
   }
 
   auto fuzz_target = info[0].As<Napi::Function>();
   auto fuzzer_args = LibFuzzerArgs(info.Env(), info[1].As<Napi::Array>());
+  auto options = ParseExecutionOptions(info.Env(), info[2].As<Napi::Object>());
 
   // Store the JS fuzz target and corresponding environment, so that the C++
   // fuzz target can use them to call back into JS.
-  auto *context = new AsyncFuzzTargetContext(info.Env());
+  auto *context = new AsyncFuzzTargetContext(info.Env(), options);
+  context->target = Napi::Persistent(fuzz_target);
+  context->parameter_count =
+      fuzz_target.Get("length").As<Napi::Number>().Int32Value();
+  CreateCallbacks(info.Env(), context);
+  profiling::Enable(options);
+  gc_scheduler::Enable(options);
 
   gTSFN = TSFN::New(
       info.Env(),         // Env
       fuzz_target,        // Callback
       "FuzzerAsyncAddon", // Name
-      0,                  // Unlimited Queue
+      1,                  // Only one iteration is in flight at a time
       1,                  // Only one thread will use this initially
       context,            // Context object passed into the callback
       [](Napi::Env env, FinalizerDataType *, AsyncFuzzTargetContext *ctx) {
@@ -324,10 +548,12 @@ Napi::Value StartFuzzingAsync(const Napi::CallbackInfo &info) {
   // Start libFuzzer in a separate thread to not block the JavaScript event
   // loop.
   context->native_thread = std::thread(
-      [](const std::vector<std::string> &fuzzer_args) {
+      [context](const std::vector<std::string> &fuzzer_args) {
         signal(SIGSEGV, ErrorSignalHandler);
         signal(SIGINT, sigintHandler);
         StartLibFuzzer(fuzzer_args, FuzzCallbackAsync);
+        profiling::Print();
+        context->next_input.Finish();
         gTSFN.Release();
       },
       std::move(fuzzer_args));
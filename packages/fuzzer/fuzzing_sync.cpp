@@ -25,8 +25,12 @@
 #define GetPID getpid
 #endif
 
+#include "fuzz_input.h"
 #include "fuzzing_sync.h"
+#include "gc_scheduler.h"
+#include "profiling.h"
 #include "shared/libfuzzer.h"
+#include "shared/tracing.h"
 #include "utils.h"
 
 namespace {
@@ -37,6 +41,7 @@ struct FuzzTargetInfo {
   bool isResolved; // indicate if the deferred is resolved or not
   Napi::Promise::Deferred deferred;
   Napi::Function jsStopCallback; // JS stop function used by signal handling.
+  ExecutionOptions options;
 };
 
 // The JS fuzz target. We need to store the function pointer in a global
@@ -81,6 +86,10 @@ void ErrorSignalHandler(int signum) {
 
 // The libFuzzer callback when fuzzing synchronously
 int FuzzCallbackSync(const uint8_t *Data, size_t Size) {
+  // Collect the garbage of the previous iterations before this one starts, so
+  // that V8 doesn't have to while the fuzz target runs.
+  gc_scheduler::CollectIfDue();
+
   // Create a new active scope so that handles for the buffer objects created in
   // this function will be associated with it. This makes sure that these
   // handles are only held live through the lifespan of this scope and gives
@@ -94,15 +103,20 @@ int FuzzCallbackSync(const uint8_t *Data, size_t Size) {
   // and only return when a bug is found. See:
   // https://github.com/nodejs/node-addon-api/blob/35b65712c26a49285cdbe2b4d04e25a5eccbe719/doc/object_lifetime_management.md
   auto scope = Napi::HandleScope(gFuzzTarget->env);
+  auto iteration = profiling::Stopwatch::Start();
+  auto stopwatch = iteration;
 
   try {
-    // TODO Do we really want to copy the data? The user isn't allowed to
-    // modify it (else the fuzzer will abort); moreover, we don't know when
-    // the JS buffer is going to be garbage-collected. But it would still be
-    // nice for efficiency if we could use a pointer instead of copying.
-    auto data = Napi::Buffer<uint8_t>::Copy(gFuzzTarget->env, Data, Size);
+    // The input is released when it goes out of scope, i.e. also in case the
+    // fuzz target threw an exception.
+    auto input = FuzzInput(gFuzzTarget->env, Data, Size,
+                           gFuzzTarget->options.zero_copy_input);
+    stopwatch.Lap(profiling::Phase::kInput);
     if (setjmp(executionContext) == 0) {
-      auto result = gFuzzTarget->target.Call({data});
+      auto result = gFuzzTarget->target.Call({input.Value()});
+      stopwatch.Lap(profiling::Phase::kTarget);
+      DrainTraceBuffer(gFuzzTarget->env, true);
+      stopwatch.Lap(profiling::Phase::kDrain);
       if (result.IsPromise()) {
         AsyncReturnsHandler();
       } else {
@@ -146,6 +160,9 @@ int FuzzCallbackSync(const uint8_t *Data, size_t Size) {
     gFuzzTarget->jsStopCallback.Call({exitCode});
   }
 
+  if (iteration.IsRunning()) {
+    profiling::RecordIteration(Data, Size, iteration.Elapsed());
+  }
   return libfuzzer::RETURN_CONTINUE;
 }
 
@@ -155,30 +172,36 @@ int FuzzCallbackSync(const uint8_t *Data, size_t Size) {
 // FuzzerMain.cpp in the compiler-rt source). It takes the fuzz target, which
 // must be a JS function taking a single data argument, as its first
 // parameter; the fuzz target's return value is ignored. The second argument
-// is an array of (command-line) arguments to pass to libfuzzer.
+// is an array of (command-line) arguments to pass to libfuzzer, the fourth one
+// an object with execution options.
 Napi::Value StartFuzzing(const Napi::CallbackInfo &info) {
-  if (info.Length() != 3 || !info[0].IsFunction() || !info[1].IsArray() ||
-      !info[2].IsFunction()) {
+  if (info.Length() != 4 || !info[0].IsFunction() || !info[1].IsArray() ||
+      !info[2].IsFunction() || !info[3].IsObject()) {
     throw Napi::Error::New(
         info.Env(),
-        "Need three arguments, which must be the fuzz target "
-        "function, an array of libfuzzer arguments, and a callback function "
-        "that the fuzzer will call in case of SIGINT or a segmentation fault");
+        "Need four arguments, which must be the fuzz target "
+        "function, an array of libfuzzer arguments, a callback function "
+        "that the fuzzer will call in case of SIGINT or a segmentation fault, "
+        "and an object with execution options");
   }
 
   auto fuzzer_args = LibFuzzerArgs(info.Env(), info[1].As<Napi::Array>());
+  auto options = ParseExecutionOptions(info.Env(), info[3].As<Napi::Object>());
 
   // Store the JS fuzz target and corresponding environment globally, so that
   // our C++ fuzz target can use them to call back into JS. Also store the stop
   // function that will be called in case of a SIGINT/SIGSEGV.
   gFuzzTarget = {info.Env(), info[0].As<Napi::Function>(), false,
                  Napi::Promise::Deferred::New(info.Env()),
-                 info[2].As<Napi::Function>()};
+                 info[2].As<Napi::Function>(), options};
 
   signal(SIGINT, sigintHandler);
   signal(SIGSEGV, ErrorSignalHandler);
 
+  profiling::Enable(options);
+  gc_scheduler::Enable(options);
   StartLibFuzzer(fuzzer_args, FuzzCallbackSync);
+  profiling::Print();
 
   // Resolve the deferred in case no error could be found during fuzzing.
   if (!gFuzzTarget->isResolved) {
@@ -0,0 +1,101 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#ifdef JAZZER_V8_API
+#include <v8.h>
+#endif
+
+#include "gc_scheduler.h"
+#include "profiling.h"
+
+namespace gc_scheduler {
+
+#ifdef JAZZER_V8_API
+namespace {
+
+// Reading the heap statistics takes about a microsecond, so the heap is only
+// checked every kCheckInterval iterations.
+constexpr uint32_t kCheckInterval = 16;
+
+// Allowed growth of the heap in bytes, 0 if scheduling is disabled.
+size_t gBudget = 0;
+// Used heap after the last full garbage collection.
+size_t gBaseline = 0;
+uint32_t gIterations = 0;
+
+size_t UsedHeapSize(v8::Isolate *isolate) {
+  v8::HeapStatistics statistics;
+  isolate->GetHeapStatistics(&statistics);
+  return statistics.used_heap_size();
+}
+
+// Called after every full garbage collection, including the ones started by
+// V8 itself.
+void UpdateBaseline(v8::Isolate *isolate, v8::GCType, v8::GCCallbackFlags) {
+  gBaseline = UsedHeapSize(isolate);
+}
+
+} // namespace
+
+void Enable(const ExecutionOptions &options) {
+  if (options.gc_budget == 0 || gBudget != 0) {
+    return;
+  }
+  gBudget = options.gc_budget;
+  auto *isolate = v8::Isolate::GetCurrent();
+  gBaseline = UsedHeapSize(isolate);
+  isolate->AddGCEpilogueCallback(UpdateBaseline, v8::kGCTypeMarkSweepCompact);
+}
+
+void CollectIfDue() {
+  if (gBudget == 0 || ++gIterations % kCheckInterval != 0) {
+    return;
+  }
+  auto *isolate = v8::Isolate::GetCurrent();
+  if (UsedHeapSize(isolate) < gBaseline + gBudget) {
+    return;
+  }
+  // Ordinary collections can only be requested with --expose-gc, which would
+  // also install a global `gc` function in every context, including the vm
+  // contexts of Jest. On the JS thread, a critical memory pressure
+  // notification directly runs a full collection instead. It reduces memory
+  // rather than just collecting: the collection isn't incremental, is repeated
+  // once if it freed a lot, and shrinks the new space, so a scheduled
+  // collection costs more than one of V8's own. The pressure has to be lifted
+  // again right away, as V8 only acts on changes of the level and tunes its
+  // heuristics for low memory meanwhile.
+  auto stopwatch = profiling::Stopwatch::Start();
+  isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+  isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kNone);
+  stopwatch.Lap(profiling::Phase::kScheduledGc);
+}
+
+#else
+// Garbage collections can only be requested through V8's C++ API.
+void Enable(const ExecutionOptions &options) {
+  if (options.gc_budget != 0) {
+    std::cerr << "WARN: gcBudget requires a build of the addon for this "
+                 "version of Node, ignoring it"
+              << std::endl;
+  }
+}
+
+void CollectIfDue() {}
+#endif // JAZZER_V8_API
+
+} // namespace gc_scheduler
@@ -0,0 +1,38 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#pragma once
+
+#include "utils.h"
+
+// Optional scheduling of full garbage collections between fuzzer iterations.
+//
+// V8 starts full garbage collections whenever its heuristics decide to, i.e.
+// usually in the middle of an iteration, which then takes much longer than the
+// others. If enabled via the `gc_budget` execution option, the growth of the
+// heap since the last full collection is checked between iterations, and a
+// collection is requested once it exceeds the budget. As long as the budget is
+// below the growth that V8 allows, its own collections don't happen anymore.
+namespace gc_scheduler {
+
+// Enable the scheduling if requested by the execution options. Has to be
+// called on the JS thread before fuzzing starts.
+void Enable(const ExecutionOptions &options);
+
+// Collect garbage if the heap grew by more than the budget. Has to be called
+// on the JS thread between iterations, when no handles of the previous
+// iteration are left.
+void CollectIfDue();
+
+} // namespace gc_scheduler
@@ -0,0 +1,294 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef JAZZER_V8_API
+#include <v8.h>
+#endif
+
+#include "profiling.h"
+
+namespace profiling {
+namespace {
+
+const char *const kPhaseNames[] = {"handoff", "input",       "beforeEach",
+                                   "target",  "afterEach",   "drain",
+                                   "gc",      "scheduledGc", "total"};
+static_assert(std::size(kPhaseNames) == static_cast<size_t>(Phase::kCount),
+              "every phase needs a name");
+
+// Index of the highest set bit of a non-zero value.
+int HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return static_cast<int>(index);
+#else
+  return 63 - __builtin_clzll(value);
+#endif
+}
+
+// A histogram of durations in nanoseconds, with the log-linear buckets of an
+// HDR histogram: every power of two is split into kSubBuckets buckets of the
+// same width, so that each value is recorded with a relative error of less
+// than 1 / kSubBuckets. Recording only increments atomic counters and never
+// blocks or allocates.
+class Histogram {
+public:
+  void Record(uint64_t value) {
+    counts_[Index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+  double Mean() const {
+    auto count = Count();
+    return count == 0 ? 0 : static_cast<double>(sum_.load()) / count;
+  }
+
+  // The highest value equivalent to the value at the given quantile, i.e. the
+  // upper bound of its bucket.
+  uint64_t ValueAt(double quantile) const {
+    auto count = Count();
+    if (count == 0) {
+      return 0;
+    }
+    auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(quantile * count)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        return std::min(LowerBound(i + 1) - 1, Max());
+      }
+    }
+    return Max();
+  }
+
+private:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr uint64_t kSubBuckets = 1 << kSubBucketBits;
+  static constexpr size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  // Values below kSubBuckets get a bucket each. Larger values are shifted
+  // right until they have kSubBucketBits + 1 bits, the shift selects the power
+  // of two and the lower bits the bucket within it.
+  static size_t Index(uint64_t value) {
+    if (value < kSubBuckets) {
+      return value;
+    }
+    auto shift = HighestBit(value) - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+  }
+
+  static uint64_t LowerBound(size_t index) {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    auto shift = index / kSubBuckets - 1;
+    return (kSubBuckets + index % kSubBuckets) << shift;
+  }
+
+  std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+// Inputs taking at least kSlowInputFactor times as long as the median
+// iteration, and at least kMinSlowInputNanos, are written to the slow input
+// directory. The median is updated every kThresholdInterval iterations, which
+// is also the number of iterations before the first input is considered.
+constexpr uint64_t kSlowInputFactor = 10;
+constexpr uint64_t kMinSlowInputNanos = 1000 * 1000;
+constexpr uint64_t kThresholdInterval = 1024;
+// Upper bound on the number of written slow inputs.
+constexpr int kMaxSlowInputs = 100;
+
+std::atomic<bool> gEnabled{false};
+std::atomic<bool> gPrinted{false};
+std::array<Histogram, static_cast<size_t>(Phase::kCount)> gHistograms;
+
+// Only accessed by the thread calling RecordIteration.
+std::string gSlowInputDirectory;
+uint64_t gSlowInputThreshold = UINT64_MAX;
+int gSlowInputs = 0;
+
+Histogram &HistogramOf(Phase phase) {
+  return gHistograms[static_cast<size_t>(phase)];
+}
+
+#ifdef JAZZER_V8_API
+// Only accessed by the JS thread, which runs the garbage collection callbacks.
+uint64_t gGcStart = 0;
+
+void GcPrologue(v8::Isolate *, v8::GCType, v8::GCCallbackFlags) {
+  gGcStart = Now();
+}
+
+void GcEpilogue(v8::Isolate *, v8::GCType, v8::GCCallbackFlags) {
+  if (gGcStart != 0) {
+    Record(Phase::kGc, Now() - gGcStart);
+    gGcStart = 0;
+  }
+}
+#endif // JAZZER_V8_API
+
+void WriteSlowInput(const uint8_t *data, size_t size, uint64_t nanos) {
+  auto path = gSlowInputDirectory + "/slow-" + std::to_string(nanos / 1000) +
+              "us-" + std::to_string(gSlowInputs++);
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char *>(data), size);
+  if (!file) {
+    std::cerr << "WARN: Failed to write slow input to " << path << std::endl;
+    return;
+  }
+  std::cerr << "INFO: Slow input (" << nanos / 1000 << " us) written to "
+            << path << std::endl;
+}
+
+double Micros(double nanos) { return nanos / 1000; }
+
+} // namespace
+
+bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+uint64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Record(Phase phase, uint64_t nanos) { HistogramOf(phase).Record(nanos); }
+
+void RecordIteration(const uint8_t *data, size_t size, uint64_t nanos) {
+  auto &total = HistogramOf(Phase::kTotal);
+  total.Record(nanos);
+  if (gSlowInputDirectory.empty()) {
+    return;
+  }
+  if (total.Count() % kThresholdInterval == 0) {
+    gSlowInputThreshold =
+        std::max(kSlowInputFactor * total.ValueAt(0.5), kMinSlowInputNanos);
+  }
+  if (nanos >= gSlowInputThreshold && gSlowInputs < kMaxSlowInputs) {
+    WriteSlowInput(data, size, nanos);
+  }
+}
+
+void Enable(const ExecutionOptions &options) {
+  if (!options.profile || gEnabled.exchange(true)) {
+    return;
+  }
+  gSlowInputDirectory = options.slow_input_directory;
+#ifdef JAZZER_V8_API
+  auto *isolate = v8::Isolate::GetCurrent();
+  isolate->AddGCPrologueCallback(GcPrologue);
+  isolate->AddGCEpilogueCallback(GcEpilogue);
+#endif
+  // libFuzzer may exit the process directly after printing its final stats,
+  // e.g. once -runs is reached.
+  std::atexit(Print);
+}
+
+void Print() {
+  if (!IsEnabled() || gPrinted.exchange(true)) {
+    return;
+  }
+  std::cerr << "== Jazzer.js iteration profile (microseconds):" << std::endl;
+  std::cerr << std::left << std::setw(12) << "phase" << std::right;
+  for (const char *column : {"count", "mean", "p50", "p90", "p99", "p99.9",
+                             "max"}) {
+    std::cerr << std::setw(12) << column;
+  }
+  std::cerr << std::endl << std::fixed << std::setprecision(1);
+  for (size_t i = 0; i < gHistograms.size(); ++i) {
+    const auto &histogram = gHistograms[i];
+    if (histogram.Count() == 0) {
+      continue;
+    }
+    std::cerr << std::left << std::setw(12) << kPhaseNames[i] << std::right
+              << std::setw(12) << histogram.Count();
+    for (double value :
+         {histogram.Mean(), static_cast<double>(histogram.ValueAt(0.5)),
+          static_cast<double>(histogram.ValueAt(0.9)),
+          static_cast<double>(histogram.ValueAt(0.99)),
+          static_cast<double>(histogram.ValueAt(0.999)),
+          static_cast<double>(histogram.Max())}) {
+      std::cerr << std::setw(12) << Micros(value);
+    }
+    std::cerr << std::endl;
+  }
+  std::cerr << std::defaultfloat;
+}
+
+// Return the recorded histograms as an object with a summary per phase, see
+// `IterationProfile` in addon.ts. Durations are given in microseconds.
+Napi::Value GetIterationProfile(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto profile = Napi::Object::New(env);
+  for (size_t i = 0; i < gHistograms.size(); ++i) {
+    const auto &histogram = gHistograms[i];
+    auto summary = Napi::Object::New(env);
+    summary["count"] =
+        Napi::Number::New(env, static_cast<double>(histogram.Count()));
+    summary["mean"] = Napi::Number::New(env, Micros(histogram.Mean()));
+    summary["p50"] = Napi::Number::New(env, Micros(histogram.ValueAt(0.5)));
+    summary["p90"] = Napi::Number::New(env, Micros(histogram.ValueAt(0.9)));
+    summary["p99"] = Napi::Number::New(env, Micros(histogram.ValueAt(0.99)));
+    summary["p999"] = Napi::Number::New(env, Micros(histogram.ValueAt(0.999)));
+    summary["max"] = Napi::Number::New(env, Micros(histogram.Max()));
+    profile[kPhaseNames[i]] = summary;
+  }
+  return profile;
+}
+
+// Record the duration of a phase measured in JS, e.g. of the callbacks run
+// around the fuzz target.
+void RecordIterationPhase(const Napi::CallbackInfo &info) {
+  if (info.Length() != 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+    throw Napi::Error::New(info.Env(),
+                           "Need two arguments: the phase and the duration in "
+                           "nanoseconds");
+  }
+  auto phase = info[0].As<Napi::Number>().Int32Value();
+  if (phase < 0 || phase >= static_cast<int>(Phase::kCount)) {
+    throw Napi::Error::New(info.Env(), "Unknown iteration phase");
+  }
+  auto nanos = info[1].As<Napi::Number>().DoubleValue();
+  Record(static_cast<Phase>(phase),
+         nanos > 0 ? static_cast<uint64_t>(nanos) : 0);
+}
+
+} // namespace profiling
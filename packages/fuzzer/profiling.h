@@ -0,0 +1,120 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <napi.h>
+
+#include "utils.h"
+
+// Optional profiling of the fuzzer iterations. If enabled via the `profile`
+// execution option, the duration of each phase of an iteration is recorded in
+// a histogram, together with the garbage collection pauses. The histograms are
+// printed after libFuzzer's final stats and can be read from JS.
+namespace profiling {
+
+// The phases of an iteration, see `IterationPhase` in addon.ts.
+enum class Phase {
+  // Hand-over of the input from the libFuzzer thread to the JS thread, only
+  // in async mode.
+  kHandoff,
+  // Creation of the Buffer passed to the fuzz target.
+  kInput,
+  // The beforeEach callbacks, reported from JS.
+  kBeforeEach,
+  // The fuzz target, until it returned or its promise settled. Includes the
+  // beforeEach and afterEach callbacks.
+  kTarget,
+  // The afterEach callbacks, reported from JS.
+  kAfterEach,
+  // Passing the recorded compare events on to libFuzzer.
+  kDrain,
+  // Garbage collection pauses, at any point of an iteration.
+  kGc,
+  // Garbage collections requested between iterations, see gc_scheduler.h.
+  kScheduledGc,
+  // The whole iteration as seen by libFuzzer.
+  kTotal,
+  kCount,
+};
+
+// Whether profiling is enabled. Timestamps should only be taken if it is.
+bool IsEnabled();
+
+// Monotonic timestamp in nanoseconds.
+uint64_t Now();
+
+// Record the duration of a phase of the current iteration. Can be called from
+// any thread.
+void Record(Phase phase, uint64_t nanos);
+
+// Record the duration of a whole iteration. If it took much longer than the
+// typical iteration, its input is written to the slow input directory.
+void RecordIteration(const uint8_t *data, size_t size, uint64_t nanos);
+
+// Enable profiling if requested by the execution options. Has to be called on
+// the JS thread before fuzzing starts.
+void Enable(const ExecutionOptions &options);
+
+// Print the histograms to stderr, once.
+void Print();
+
+// Measures the phases of an iteration one after the other. Only runs if
+// profiling is enabled, so that it costs a single check otherwise.
+class Stopwatch {
+public:
+  // A stopwatch that is not running.
+  Stopwatch() = default;
+
+  // Start a stopwatch, if profiling is enabled.
+  static Stopwatch Start() {
+    Stopwatch stopwatch;
+    if (IsEnabled()) {
+      stopwatch.start_ = Now();
+    }
+    return stopwatch;
+  }
+
+  bool IsRunning() const { return start_ != 0; }
+  uint64_t Elapsed() const { return Now() - start_; }
+
+  // Record the time since the start or the previous lap for the given phase.
+  void Lap(Phase phase) {
+    if (IsRunning()) {
+      auto now = Now();
+      Record(phase, now - start_);
+      start_ = now;
+    }
+  }
+
+  // Leave out the time since the start or the previous lap from all phases.
+  void Restart() {
+    if (IsRunning()) {
+      start_ = Now();
+    }
+  }
+
+  void Stop() { start_ = 0; }
+
+private:
+  uint64_t start_ = 0;
+};
+
+Napi::Value GetIterationProfile(const Napi::CallbackInfo &info);
+void RecordIterationPhase(const Napi::CallbackInfo &info);
+
+} // namespace profiling
@@ -0,0 +1,69 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Identifiers of JS call sites, used for the hook IDs passed to the hook
+// functions of bug detectors and custom hooks.
+//
+// Node-API doesn't provide access to the JS stack, so this uses V8 directly,
+// which binds the addon to the Node ABI it was built for (see CMakeLists.txt).
+// Without the V8 headers, callSiteId isn't exported and the hooking package
+// hashes the formatted JS stack trace instead.
+
+#ifdef JAZZER_V8_API
+
+#include "call_site.h"
+
+#include <cstdint>
+#include <v8.h>
+
+namespace {
+// Number of frames identifying a call site, the default stack trace limit.
+constexpr int kCallSiteFrames = 10;
+
+constexpr auto kFrameDetails = static_cast<v8::StackTrace::StackTraceOptions>(
+    v8::StackTrace::kScriptId | v8::StackTrace::kLineNumber |
+    v8::StackTrace::kColumnOffset);
+
+// FNV-1a over the bytes of the value.
+void Mix(uint32_t &hash, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    hash ^= (value >> (i * 8)) & 0xff;
+    hash *= 16777619;
+  }
+}
+} // namespace
+
+// Derive an ID from the script, line and column of the top frames of the
+// current stack trace, without formatting it. The optional argument is a seed
+// mixed into the ID, e.g. to distinguish call sites of different hooks.
+Napi::Value CallSiteId(const Napi::CallbackInfo &info) {
+  uint32_t hash = 2166136261;
+  if (info.Length() > 0) {
+    Mix(hash, info[0].As<Napi::Number>().Uint32Value());
+  }
+
+  auto *isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope scope(isolate);
+  auto trace = v8::StackTrace::CurrentStackTrace(isolate, kCallSiteFrames,
+                                                 kFrameDetails);
+  for (int i = 0; i < trace->GetFrameCount(); ++i) {
+    auto frame = trace->GetFrame(isolate, i);
+    Mix(hash, static_cast<uint32_t>(frame->GetScriptId()));
+    Mix(hash, static_cast<uint32_t>(frame->GetLineNumber()));
+    Mix(hash, static_cast<uint32_t>(frame->GetColumn()));
+  }
+  return Napi::Number::New(info.Env(), static_cast<int32_t>(hash));
+}
+
+#endif // JAZZER_V8_API
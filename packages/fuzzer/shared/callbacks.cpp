@@ -13,21 +13,49 @@
 // limitations under the License.
 
 #include "callbacks.h"
+#include "call_site.h"
 #include "coverage.h"
+#include "edge_ids.h"
+#include "heap_monitor.h"
+#include "prototypes.h"
 #include "tracing.h"
 
 void RegisterCallbackExports(Napi::Env env, Napi::Object exports) {
+  exports["createCoverageMap"] = Napi::Function::New<CreateCoverageMap>(env);
   exports["registerCoverageMap"] =
       Napi::Function::New<RegisterCoverageMap>(env);
   exports["registerNewCounters"] =
       Napi::Function::New<RegisterNewCounters>(env);
   exports["registerModuleCounters"] =
       Napi::Function::New<RegisterModuleCounters>(env);
+  exports["allocateModuleCounters"] =
+      Napi::Function::New<AllocateModuleCounters>(env);
+  exports["registerCounterSymbols"] =
+      Napi::Function::New<RegisterCounterSymbols>(env);
+  exports["openEdgeIdTable"] = Napi::Function::New<OpenEdgeIdTable>(env);
+  exports["claimEdgeIds"] = Napi::Function::New<ClaimEdgeIds>(env);
+  exports["commitEdgeIds"] = Napi::Function::New<CommitEdgeIds>(env);
   exports["traceUnequalStrings"] =
       Napi::Function::New<TraceUnequalStrings>(env);
   exports["traceStringContainment"] =
       Napi::Function::New<TraceStringContainment>(env);
+  exports["traceUnequalBytes"] = Napi::Function::New<TraceUnequalBytes>(env);
+  exports["traceBytesContainment"] =
+      Napi::Function::New<TraceBytesContainment>(env);
   exports["traceIntegerCompare"] =
       Napi::Function::New<TraceIntegerCompare>(env);
+#ifdef JAZZER_V8_API
+  exports["callSiteId"] = Napi::Function::New<CallSiteId>(env);
+#endif
+  exports["fingerprintPrototypes"] =
+      Napi::Function::New<FingerprintPrototypes>(env);
+#ifdef JAZZER_V8_API
+  exports["monitorHeap"] = Napi::Function::New<MonitorHeap>(env);
+#endif
+  exports["registerSwitchCases"] =
+      Napi::Function::New<RegisterSwitchCases>(env);
   exports["tracePcIndir"] = Napi::Function::New<TracePcIndir>(env);
+  exports["registerTraceBuffer"] =
+      Napi::Function::New<RegisterTraceBuffer>(env);
+  exports["flushTraceBuffer"] = Napi::Function::New<FlushTraceBuffer>(env);
 }
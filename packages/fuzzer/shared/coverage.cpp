@@ -13,8 +13,21 @@
 // limitations under the License.
 #include "coverage.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 extern "C" {
 void __sanitizer_cov_8bit_counters_init(uint8_t *start, uint8_t *end);
@@ -27,16 +40,125 @@ namespace {
 // Individual slices are registered with libFuzzer by RegisterNewCounters.
 uint8_t *gCoverageCounters = nullptr;
 
+// Number of counters the address space is reserved for by CreateCoverageMap.
+// Only the pages backing registered counters are committed, so the reserved
+// size doesn't cost any memory.
+constexpr std::size_t kReservedCounters =
+    sizeof(void *) == 8 ? std::size_t{1} << 30 : std::size_t{1} << 26;
+
+// Size of the coverage map and the number of counters backed by committed
+// memory. Zero for a map allocated in JavaScript, which is fully usable from
+// the start.
+std::size_t gReservedCounters = 0;
+std::size_t gCommittedCounters = 0;
+
+std::size_t PageSize() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+uint8_t *ReserveMemory(std::size_t size) {
+#ifdef _WIN32
+  return static_cast<uint8_t *>(
+      VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+#else
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  void *memory = mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+  return memory == MAP_FAILED ? nullptr : static_cast<uint8_t *>(memory);
+#endif
+}
+
+bool CommitMemory(uint8_t *start, std::size_t size) {
+#ifdef _WIN32
+  return VirtualAlloc(start, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+  return mprotect(start, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void ReleaseMemory(uint8_t *start, std::size_t size) {
+#ifdef _WIN32
+  VirtualFree(start, 0, MEM_RELEASE);
+#else
+  munmap(start, size);
+#endif
+}
+
+// The counters of ES modules are carved out of a separate reservation, which
+// is committed and registered with libFuzzer in slabs of kModuleSlabSize
+// counters. Registering every module on its own would make libFuzzer manage
+// thousands of tiny modules in large applications, each with its own PC table.
+constexpr std::size_t kReservedModuleCounters =
+    sizeof(void *) == 8 ? std::size_t{1} << 28 : std::size_t{1} << 24;
+constexpr std::size_t kModuleSlabSize = std::size_t{1} << 16;
+
+uint8_t *gModuleCounters = nullptr;
+// Counters handed out to modules and counters registered with libFuzzer.
+std::size_t gAllocatedModuleCounters = 0;
+std::size_t gRegisteredModuleCounters = 0;
+
 // PC-Table is used by libFuzzer to keep track of program addresses
 // corresponding to coverage counters. The flags determine whether the
-// corresponding counter is the beginning of a function; we don't currently use
-// it.
+// corresponding counter is the beginning of a function, which libFuzzer uses
+// for -focus_function, -print_funcs and -print_coverage.
 struct PCTableEntry {
   uintptr_t PC, PCFlags;
 };
 static_assert(sizeof(PCTableEntry) == 2 * sizeof(uintptr_t),
               "PCTableEntry must match sanitizer PC table layout");
 
+// See PcIsFuncEntry in libFuzzer's FuzzerTracePC.h.
+constexpr uintptr_t kFunctionEntryFlag = 1;
+
+// JavaScript counters are not associated with real code, so they get
+// synthetic PCs instead, which are unique across all registered counter
+// regions. libFuzzer passes the address of the "next instruction" to the
+// symbolizer, i.e. PC + 1 or PC + 4 depending on the architecture, so
+// consecutive PCs are spaced far enough apart to map such addresses back to
+// the same counter.
+constexpr uintptr_t kSyntheticPcBase = 0x10000;
+constexpr uintptr_t kSyntheticPcStride = 16;
+
+// A counter region registered with libFuzzer, its PC table and the index of
+// the synthetic PC of its first counter.
+struct CounterRegion {
+  std::size_t first_pc_index;
+  uint8_t *start;
+  std::size_t size;
+  PCTableEntry *pcs;
+};
+
+// Source location of a counter, see EdgeSymbols in the instrumentor. Lines
+// and columns are 1-based, 0 if unknown.
+struct EdgeLocation {
+  uint32_t function;
+  uint32_t line;
+  uint32_t column;
+};
+
+// Source locations of the counters of one module, starting at the counter the
+// table is keyed with in gCounterSymbols.
+struct CounterSymbols {
+  std::string file;
+  std::vector<std::string> functions;
+  std::vector<EdgeLocation> edges;
+};
+
+// libFuzzer symbolizes PCs from its own thread in async mode, while modules
+// can still be loaded on the JS thread, so the tables are guarded by a mutex.
+std::mutex gSymbolsMutex;
+std::vector<CounterRegion> gCounterRegions;
+std::size_t gNumPcs = 0;
+std::map<const uint8_t *, CounterSymbols> gCounterSymbols;
+
 void RegisterCounterRange(uint8_t *start, uint8_t *end) {
   if (start >= end) {
     return;
@@ -45,16 +167,21 @@ void RegisterCounterRange(uint8_t *start, uint8_t *end) {
   auto num_counters = static_cast<std::size_t>(end - start);
 
   // libFuzzer requires an array containing the instruction addresses
-  // associated with the coverage counters. Since these JavaScript counters are
-  // synthetic and not associated with real code, we create PC entries with the
-  // flag set to 0 to indicate they are not real function-entry PCs. The PC
-  // value is set to the local counter index for identification purposes.
+  // associated with the coverage counters. Function entries are only known
+  // once the symbols of the counters are registered, so the flags start out
+  // as 0 and are set by RegisterCounterSymbols.
   //
   // Intentionally never freed: libFuzzer holds a raw pointer to this table via
   // __sanitizer_cov_pcs_init and may read it at any time.
   auto *pc_entries = new PCTableEntry[num_counters];
-  for (std::size_t i = 0; i < num_counters; ++i) {
-    pc_entries[i] = {i, 0};
+  {
+    std::lock_guard<std::mutex> lock(gSymbolsMutex);
+    for (std::size_t i = 0; i < num_counters; ++i) {
+      pc_entries[i] = {kSyntheticPcBase + (gNumPcs + i) * kSyntheticPcStride,
+                       0};
+    }
+    gCounterRegions.push_back({gNumPcs, start, num_counters, pc_entries});
+    gNumPcs += num_counters;
   }
 
   auto *pc_entries_end = pc_entries + num_counters;
@@ -62,6 +189,137 @@ void RegisterCounterRange(uint8_t *start, uint8_t *end) {
   __sanitizer_cov_pcs_init(reinterpret_cast<const uintptr_t *>(pc_entries),
                            reinterpret_cast<const uintptr_t *>(pc_entries_end));
 }
+
+// Look up the symbols of the counter with the given synthetic PC. Has to be
+// called with gSymbolsMutex held.
+const CounterSymbols *ResolvePc(uintptr_t pc, std::size_t &edge) {
+  if (pc < kSyntheticPcBase) {
+    return nullptr;
+  }
+  auto pc_index = (pc - kSyntheticPcBase) / kSyntheticPcStride;
+  auto region = std::upper_bound(
+      gCounterRegions.begin(), gCounterRegions.end(), pc_index,
+      [](std::size_t index, const CounterRegion &region) {
+        return index < region.first_pc_index;
+      });
+  if (region == gCounterRegions.begin()) {
+    return nullptr;
+  }
+  --region;
+  if (pc_index - region->first_pc_index >= region->size) {
+    return nullptr;
+  }
+  const uint8_t *counter =
+      region->start + (pc_index - region->first_pc_index);
+
+  auto symbols = gCounterSymbols.upper_bound(counter);
+  if (symbols == gCounterSymbols.begin()) {
+    return nullptr;
+  }
+  --symbols;
+  edge = static_cast<std::size_t>(counter - symbols->first);
+  if (edge >= symbols->second.edges.size()) {
+    return nullptr;
+  }
+  return &symbols->second;
+}
+
+std::string Hex(uintptr_t value) {
+  char buffer[2 + 2 * sizeof(uintptr_t) + 1];
+  std::snprintf(buffer, sizeof(buffer), "0x%zx", static_cast<size_t>(value));
+  return buffer;
+}
+
+// Flag the PC table entries of the given function-entry counters, which are
+// relative to start. Has to be called with gSymbolsMutex held.
+void MarkFunctionEntries(const uint8_t *start, std::size_t num_counters,
+                         const uint32_t *entries, std::size_t num_entries) {
+  for (const auto &region : gCounterRegions) {
+    // The counters of a module may span several regions, either of the
+    // global coverage map or of the module slabs.
+    if (region.start >= start + num_counters ||
+        region.start + region.size <= start) {
+      continue;
+    }
+    for (std::size_t i = 0; i < num_entries; ++i) {
+      const uint8_t *counter = start + entries[i];
+      if (counter >= region.start && counter < region.start + region.size) {
+        region.pcs[counter - region.start].PCFlags |= kFunctionEntryFlag;
+      }
+    }
+  }
+}
+
+// Render the PC description in the format used by the sanitizer symbolizer,
+// see RenderFrame in compiler-rt's sanitizer_stacktrace_printer.cpp. Only
+// the placeholders that make sense for JavaScript are supported.
+std::string RenderPc(const char *fmt, uintptr_t pc,
+                     const CounterSymbols *symbols, std::size_t edge) {
+  const std::string unknown = "<unknown>";
+  const auto &file = symbols ? symbols->file : unknown;
+  EdgeLocation location = symbols ? symbols->edges[edge] : EdgeLocation{};
+  const auto &function =
+      symbols && location.function < symbols->functions.size()
+          ? symbols->functions[location.function]
+          : unknown;
+  auto source_location = [&]() {
+    auto result = file;
+    if (location.line != 0) {
+      result += ":" + std::to_string(location.line);
+      if (location.column != 0) {
+        result += ":" + std::to_string(location.column);
+      }
+    }
+    return result;
+  };
+
+  std::string out;
+  for (const char *p = fmt; *p != '\0'; ++p) {
+    if (*p != '%' || p[1] == '\0') {
+      out += *p;
+      continue;
+    }
+    switch (*++p) {
+    case 'p':
+      out += Hex(pc);
+      break;
+    case 'm':
+    case 's':
+      out += file;
+      break;
+    case 'o':
+      out += Hex(edge);
+      break;
+    case 'f':
+      out += function;
+      break;
+    case 'l':
+      out += std::to_string(location.line);
+      break;
+    case 'c':
+      out += std::to_string(location.column);
+      break;
+    case 'F':
+      out += "in " + function;
+      break;
+    case 'L':
+    case 'S':
+      out += source_location();
+      break;
+    case 'M':
+      out += "(" + file + "+" + Hex(edge) + ")";
+      break;
+    case '%':
+      out += '%';
+      break;
+    default:
+      out += '%';
+      out += *p;
+      break;
+    }
+  }
+  return out;
+}
 } // namespace
 
 void RegisterCoverageMap(const Napi::CallbackInfo &info) {
@@ -78,7 +336,40 @@ void RegisterCoverageMap(const Napi::CallbackInfo &info) {
   gCoverageCounters = reinterpret_cast<uint8_t *>(buf.Data());
 }
 
-void RegisterNewCounters(const Napi::CallbackInfo &info) {
+// Reserve address space for the global coverage map and return a Buffer
+// backed by it, without committing any memory yet. Returns undefined if the
+// environment doesn't support this, e.g. if external buffers are not allowed
+// as in Electron, in which case the map has to be allocated in JavaScript and
+// passed to RegisterCoverageMap.
+Napi::Value CreateCoverageMap(const Napi::CallbackInfo &info) {
+  if (gCoverageCounters != nullptr) {
+    throw Napi::Error::New(info.Env(), "Coverage map already registered");
+  }
+
+  auto *memory = ReserveMemory(kReservedCounters);
+  if (memory == nullptr) {
+    return info.Env().Undefined();
+  }
+  // The memory stays mapped for the lifetime of the process, libFuzzer holds
+  // on to the registered counters, so the buffer has no finalizer.
+  napi_value buffer;
+  if (napi_create_external_buffer(info.Env(), kReservedCounters, memory,
+                                  nullptr, nullptr, &buffer) != napi_ok) {
+    ReleaseMemory(memory, kReservedCounters);
+    return info.Env().Undefined();
+  }
+
+  gCoverageCounters = memory;
+  gReservedCounters = kReservedCounters;
+  return Napi::Value(info.Env(), buffer);
+}
+
+// Register the counters from old_num_counters to new_num_counters with
+// libFuzzer and return the new number of registered counters. For a map
+// created by CreateCoverageMap, the counters are rounded up to full pages,
+// which are committed first. This keeps the regions libFuzzer scans page
+// aligned, as required by e.g. its -lazy_counters option.
+Napi::Value RegisterNewCounters(const Napi::CallbackInfo &info) {
   if (info.Length() != 2) {
     throw Napi::Error::New(
         info.Env(), "Need two arguments: the old and new number of counters");
@@ -97,11 +388,32 @@ void RegisterNewCounters(const Napi::CallbackInfo &info) {
         "new_num_counters must not be smaller than old_num_counters");
   }
   if (new_num_counters == old_num_counters) {
-    return;
+    return Napi::Number::New(info.Env(), static_cast<double>(new_num_counters));
+  }
+
+  if (gReservedCounters != 0) {
+    auto page_size = PageSize();
+    auto end = (static_cast<std::size_t>(new_num_counters) + page_size - 1) /
+               page_size * page_size;
+    if (end > gReservedCounters) {
+      throw Napi::Error::New(
+          info.Env(), "Maximum number (" + std::to_string(gReservedCounters) +
+                          ") of coverage counters exceeded");
+    }
+    if (end > gCommittedCounters) {
+      if (!CommitMemory(gCoverageCounters + gCommittedCounters,
+                        end - gCommittedCounters)) {
+        throw Napi::Error::New(info.Env(),
+                               "Failed to commit memory for coverage counters");
+      }
+      gCommittedCounters = end;
+    }
+    new_num_counters = static_cast<int64_t>(end);
   }
 
   RegisterCounterRange(gCoverageCounters + old_num_counters,
                        gCoverageCounters + new_num_counters);
+  return Napi::Number::New(info.Env(), static_cast<double>(new_num_counters));
 }
 
 // Register an independent coverage counter region for a single ES module.
@@ -121,3 +433,142 @@ void RegisterModuleCounters(const Napi::CallbackInfo &info) {
 
   RegisterCounterRange(buf.Data(), buf.Data() + size);
 }
+
+// Allocate the counters of an ES module from the module slabs and return a
+// Buffer viewing them. Slabs are registered with libFuzzer as a whole, so
+// allocating counters doesn't register a new region most of the time, and a
+// module may span two adjacent slabs. Returns undefined if the slabs can't be
+// used, in which case the module has to allocate its counters in JavaScript
+// and pass them to RegisterModuleCounters.
+Napi::Value AllocateModuleCounters(const Napi::CallbackInfo &info) {
+  if (info.Length() != 1 || !info[0].IsNumber()) {
+    throw Napi::Error::New(info.Env(),
+                           "Need one argument: the number of counters");
+  }
+  auto size = info[0].As<Napi::Number>().Int64Value();
+  if (size < 0) {
+    throw Napi::Error::New(info.Env(),
+                           "The number of counters must not be negative");
+  }
+  auto num_counters = static_cast<std::size_t>(size);
+
+  if (gModuleCounters == nullptr) {
+    gModuleCounters = ReserveMemory(kReservedModuleCounters);
+    if (gModuleCounters == nullptr) {
+      return info.Env().Undefined();
+    }
+  }
+  if (num_counters > kReservedModuleCounters - gAllocatedModuleCounters) {
+    return info.Env().Undefined();
+  }
+
+  auto *start = gModuleCounters + gAllocatedModuleCounters;
+  auto end = gAllocatedModuleCounters + num_counters;
+  if (end > gRegisteredModuleCounters) {
+    auto slab_end = std::min(
+        (end + kModuleSlabSize - 1) / kModuleSlabSize * kModuleSlabSize,
+        kReservedModuleCounters);
+    auto *slab = gModuleCounters + gRegisteredModuleCounters;
+    if (!CommitMemory(slab, slab_end - gRegisteredModuleCounters)) {
+      throw Napi::Error::New(info.Env(),
+                             "Failed to commit memory for coverage counters");
+    }
+    RegisterCounterRange(slab, gModuleCounters + slab_end);
+    gRegisteredModuleCounters = slab_end;
+  }
+
+  // The slabs are never unmapped, so the buffer has no finalizer.
+  napi_value buffer;
+  if (napi_create_external_buffer(info.Env(), num_counters, start, nullptr,
+                                  nullptr, &buffer) != napi_ok) {
+    return info.Env().Undefined();
+  }
+  gAllocatedModuleCounters = end;
+  return Napi::Value(info.Env(), buffer);
+}
+
+// Register the source locations of the counters in the given buffer, which
+// were emitted by the instrumentor, for symbolizing their synthetic PCs, and
+// flag the counters at function entries in the PC table.
+void RegisterCounterSymbols(const Napi::CallbackInfo &info) {
+  if (info.Length() != 5 || !info[0].IsBuffer() || !info[1].IsString() ||
+      !info[2].IsArray() || !info[3].IsTypedArray() ||
+      !info[4].IsTypedArray()) {
+    throw Napi::Error::New(
+        info.Env(), "Need five arguments: a Buffer of 8-bit counters, the file "
+                    "name, the function names, the edge locations and the "
+                    "function entries");
+  }
+
+  auto counters = info[0].As<Napi::Buffer<uint8_t>>();
+  auto functions = info[2].As<Napi::Array>();
+  auto locations = info[3].As<Napi::Uint32Array>();
+  auto entries = info[4].As<Napi::Uint32Array>();
+  if (locations.ElementLength() != 3 * counters.Length()) {
+    throw Napi::Error::New(info.Env(),
+                           "Expected one location per coverage counter");
+  }
+  for (std::size_t i = 0; i < entries.ElementLength(); ++i) {
+    if (entries[i] >= counters.Length()) {
+      throw Napi::Error::New(info.Env(),
+                             "Function entry is not a coverage counter");
+    }
+  }
+
+  CounterSymbols symbols;
+  symbols.file = info[1].As<Napi::String>().Utf8Value();
+  symbols.functions.reserve(functions.Length());
+  for (uint32_t i = 0; i < functions.Length(); ++i) {
+    symbols.functions.push_back(
+        functions.Get(i).As<Napi::String>().Utf8Value());
+  }
+  symbols.edges.reserve(counters.Length());
+  for (std::size_t i = 0; i < counters.Length(); ++i) {
+    symbols.edges.push_back(
+        {locations[3 * i], locations[3 * i + 1], locations[3 * i + 2]});
+  }
+
+  std::lock_guard<std::mutex> lock(gSymbolsMutex);
+  // Modules evaluated again, e.g. by Jest, reuse their counters in the global
+  // coverage map and replace the previous table.
+  gCounterSymbols[counters.Data()] = std::move(symbols);
+  MarkFunctionEntries(counters.Data(), counters.Length(), entries.Data(),
+                      entries.ElementLength());
+}
+
+// Called by libFuzzer to describe PCs, e.g. for -print_pcs and
+// -print_coverage. Synthetic PCs of JavaScript counters are resolved to the
+// source locations registered by RegisterCounterSymbols.
+extern "C" [[maybe_unused]] void __sanitizer_symbolize_pc(void *pc,
+                                                         const char *fmt,
+                                                         char *out_buf,
+                                                         size_t out_buf_size) {
+  if (out_buf_size == 0) {
+    return;
+  }
+  std::string description;
+  {
+    std::lock_guard<std::mutex> lock(gSymbolsMutex);
+    std::size_t edge = 0;
+    auto pc_value = reinterpret_cast<uintptr_t>(pc);
+    description = RenderPc(fmt, pc_value, ResolvePc(pc_value, edge), edge);
+  }
+  std::snprintf(out_buf, out_buf_size, "%s", description.c_str());
+}
+
+extern "C" [[maybe_unused]] int
+__sanitizer_get_module_and_offset_for_pc(void *pc, char *module_path,
+                                         size_t module_path_len,
+                                         void **pc_offset) {
+  std::lock_guard<std::mutex> lock(gSymbolsMutex);
+  std::size_t edge = 0;
+  auto symbols = ResolvePc(reinterpret_cast<uintptr_t>(pc), edge);
+  if (symbols == nullptr) {
+    return 0;
+  }
+  if (module_path_len > 0) {
+    std::snprintf(module_path, module_path_len, "%s", symbols->file.c_str());
+  }
+  *pc_offset = reinterpret_cast<void *>(edge);
+  return 1;
+}
@@ -15,6 +15,9 @@
 #pragma once
 #include <napi.h>
 
+Napi::Value CreateCoverageMap(const Napi::CallbackInfo &info);
 void RegisterCoverageMap(const Napi::CallbackInfo &info);
-void RegisterNewCounters(const Napi::CallbackInfo &info);
+Napi::Value RegisterNewCounters(const Napi::CallbackInfo &info);
 void RegisterModuleCounters(const Napi::CallbackInfo &info);
+Napi::Value AllocateModuleCounters(const Napi::CallbackInfo &info);
+void RegisterCounterSymbols(const Napi::CallbackInfo &info);
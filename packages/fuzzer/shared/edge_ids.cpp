@@ -0,0 +1,348 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Edge ID table shared by all processes of a fuzzing campaign.
+//
+// In fork and jobs mode, every process instruments the source files it loads
+// itself, but a file has to get the same edge IDs in all of them. The IDs of
+// all source files are kept in a table in a memory-mapped file: an open
+// addressing hash table from the file name to its first edge ID and number of
+// edges. The first process to claim the slot of a file instruments it and then
+// allocates its IDs by atomically bumping the next free ID. Other processes
+// instrumenting the same file meanwhile wait for the slot to be committed,
+// processes instrumenting other files don't wait at all. Claims are held by
+// threads, as e.g. Jest worker threads instrument files concurrently, and a
+// file whose claim isn't committed in time gets IDs that are only valid in
+// the waiting process.
+//
+// The file persists after the campaign, so later runs with the same table
+// assign the same IDs without instrumenting files up front.
+
+#include "edge_ids.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// Identifies the format of the table file, bumped on incompatible changes.
+constexpr uint64_t kMagic = 0x4a5a5a4944530002;
+
+// Number of source files the table has room for. The file is sparse, only
+// the pages of used slots take up memory and disk space.
+constexpr uint32_t kNumSlots = 1 << 18;
+
+// Waiting for the claim of another thread is given up after this long, e.g.
+// if it hangs or was left over by a crashed thread of an earlier process
+// with the same ID.
+constexpr auto kClaimTimeout = std::chrono::seconds(30);
+
+enum SlotState : uint32_t { kEmpty = 0, kClaimed = 1, kCommitted = 2 };
+
+// The key is the hash of the file name, the check a second, independent
+// hash, so that hash collisions are detected. The owner is the process ID in
+// the lower and a token of the thread in the upper half.
+struct Slot {
+  std::atomic<uint64_t> key;
+  std::atomic<uint64_t> check;
+  std::atomic<uint64_t> owner;
+  std::atomic<uint32_t> state;
+  std::atomic<uint32_t> first_id;
+  std::atomic<uint32_t> count;
+  uint32_t reserved;
+};
+
+struct Table {
+  std::atomic<uint64_t> magic;
+  std::atomic<uint32_t> next_id;
+  uint8_t reserved[52];
+  Slot slots[kNumSlots];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "the table is shared between processes");
+static_assert(sizeof(Slot) == 40 && offsetof(Table, slots) == 64,
+              "the table layout is part of the file format");
+
+// Outcome of looking up the slot of a file to instrument.
+enum class Claim { kCommitted, kOwner, kTimedOut };
+
+std::vector<Table *> gTables;
+std::map<std::string, std::size_t> gTableIndices;
+std::atomic<uint32_t> gNextThreadToken{1};
+
+uint64_t Hash(const std::string &name, uint64_t basis) {
+  // FNV-1a
+  uint64_t hash = basis;
+  for (unsigned char c : name) {
+    hash ^= c;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+uint32_t CurrentProcess() {
+#ifdef _WIN32
+  return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+  return static_cast<uint32_t>(getpid());
+#endif
+}
+
+// Identifies the calling thread in the owner of a slot.
+uint64_t CurrentOwner() {
+  thread_local const uint32_t token = gNextThreadToken.fetch_add(1);
+  return static_cast<uint64_t>(token) << 32 | CurrentProcess();
+}
+
+bool IsProcessAlive(uint32_t pid) {
+#ifdef _WIN32
+  HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+  if (process == nullptr) {
+    return GetLastError() == ERROR_ACCESS_DENIED;
+  }
+  bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+  CloseHandle(process);
+  return alive;
+#else
+  return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+Table *MapTable(const std::string &path) {
+  constexpr std::size_t size = sizeof(Table);
+#ifdef _WIN32
+  HANDLE file = CreateFileA(
+      path.c_str(), GENERIC_READ | GENERIC_WRITE,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+      OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  // Grows the file to the size of the table if needed.
+  HANDLE mapping = CreateFileMappingA(
+      file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+      static_cast<DWORD>(size & 0xffffffff), nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  void *memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  CloseHandle(mapping);
+  return static_cast<Table *>(memory);
+#else
+  int fd = open(path.c_str(), O_RDWR | O_CREAT, 0600);
+  if (fd == -1) {
+    return nullptr;
+  }
+  // Processes growing the file concurrently all grow it to the same size,
+  // which keeps the content.
+  struct stat info {};
+  if (fstat(fd, &info) != 0 ||
+      (static_cast<std::size_t>(info.st_size) < size &&
+       ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+    close(fd);
+    return nullptr;
+  }
+  void *memory =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  return memory == MAP_FAILED ? nullptr : static_cast<Table *>(memory);
+#endif
+}
+
+void UnmapTable(Table *table) {
+#ifdef _WIN32
+  UnmapViewOfFile(table);
+#else
+  munmap(table, sizeof(Table));
+#endif
+}
+
+Table *TableArg(const Napi::CallbackInfo &info) {
+  auto index = info[0].As<Napi::Number>().Uint32Value();
+  if (index >= gTables.size()) {
+    throw Napi::Error::New(info.Env(), "Invalid edge ID table");
+  }
+  return gTables[index];
+}
+
+// Wait for the slot to be committed. Slots claimed by processes that died in
+// the meantime are taken over, in which case the caller becomes the owner.
+Claim AwaitCommit(Slot &slot) {
+  auto self = CurrentOwner();
+  auto deadline = std::chrono::steady_clock::now() + kClaimTimeout;
+  for (auto spins = 0;; ++spins) {
+    if (slot.state.load(std::memory_order_acquire) == kCommitted) {
+      return Claim::kCommitted;
+    }
+    auto claimant = slot.owner.load(std::memory_order_relaxed);
+    // Claims of this thread are left over from a crashed earlier run with the
+    // same process ID, as a thread instruments files one at a time. Other
+    // threads of this process may still be instrumenting the file.
+    if (slot.state.load(std::memory_order_acquire) == kClaimed &&
+        (claimant == self ||
+         !IsProcessAlive(static_cast<uint32_t>(claimant & 0xffffffff)))) {
+      if (slot.owner.compare_exchange_strong(claimant, self)) {
+        return Claim::kOwner;
+      }
+      continue;
+    }
+    if (spins < 64) {
+      std::this_thread::yield();
+    } else if (std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } else {
+      return Claim::kTimedOut;
+    }
+  }
+}
+
+// Find the slot of the given file. If claim is set, a free one is claimed if
+// there is none, and the outcome of waiting for the slot is stored in result.
+Slot *FindSlot(Table *table, const std::string &filename, bool claim,
+               Claim *result) {
+  auto key = Hash(filename, 0xcbf29ce484222325) | 1;
+  auto check = Hash(filename, 0x84222325cbf29ce4);
+  for (uint32_t probe = 0; probe < kNumSlots; ++probe) {
+    auto &slot = table->slots[(key + probe) % kNumSlots];
+    uint64_t found = 0;
+    if (claim && slot.key.compare_exchange_strong(found, key)) {
+      slot.check.store(check, std::memory_order_relaxed);
+      slot.owner.store(CurrentOwner(), std::memory_order_relaxed);
+      slot.state.store(kClaimed, std::memory_order_release);
+      *result = Claim::kOwner;
+      return &slot;
+    }
+    if (!claim) {
+      found = slot.key.load(std::memory_order_acquire);
+      if (found == 0) {
+        return nullptr;
+      }
+    }
+    if (found != key) {
+      continue;
+    }
+    // The check is published together with the claim.
+    while (slot.state.load(std::memory_order_acquire) == kEmpty) {
+      std::this_thread::yield();
+    }
+    if (slot.check.load(std::memory_order_relaxed) != check) {
+      continue;
+    }
+    if (claim) {
+      *result = AwaitCommit(slot);
+    }
+    return &slot;
+  }
+  return nullptr;
+}
+} // namespace
+
+// Open the edge ID table in the given file, creating it if needed. Returns
+// the index of the table for the other functions, undefined if the file
+// can't be mapped or has an incompatible format.
+Napi::Value OpenEdgeIdTable(const Napi::CallbackInfo &info) {
+  auto path = info[0].As<Napi::String>().Utf8Value();
+  auto existing = gTableIndices.find(path);
+  if (existing != gTableIndices.end()) {
+    return Napi::Number::New(info.Env(),
+                             static_cast<double>(existing->second));
+  }
+
+  auto *table = MapTable(path);
+  if (table == nullptr) {
+    return info.Env().Undefined();
+  }
+  uint64_t magic = 0;
+  if (!table->magic.compare_exchange_strong(magic, kMagic) &&
+      magic != kMagic) {
+    UnmapTable(table);
+    return info.Env().Undefined();
+  }
+  gTables.push_back(table);
+  gTableIndices[path] = gTables.size() - 1;
+  return Napi::Number::New(info.Env(),
+                           static_cast<double>(gTables.size() - 1));
+}
+
+// Look up the edge IDs of a source file. Returns [first ID, number of edges]
+// if they are known, waiting for another thread instrumenting the file at the
+// moment. Otherwise, the file is claimed for the caller, who has to
+// instrument it and commit its number of edges, and null is returned. If the
+// other thread doesn't commit in time, undefined is returned, and the caller
+// has to commit the number of edges without sharing them.
+Napi::Value ClaimEdgeIds(const Napi::CallbackInfo &info) {
+  auto *table = TableArg(info);
+  auto filename = info[1].As<Napi::String>().Utf8Value();
+  auto claim = Claim::kCommitted;
+  auto *slot = FindSlot(table, filename, true, &claim);
+  if (slot == nullptr) {
+    throw Napi::Error::New(info.Env(), "Edge ID table is full");
+  }
+  if (claim == Claim::kOwner) {
+    return info.Env().Null();
+  }
+  if (claim == Claim::kTimedOut) {
+    return info.Env().Undefined();
+  }
+  auto ids = Napi::Array::New(info.Env(), 2);
+  ids[0u] = Napi::Number::New(
+      info.Env(), slot->first_id.load(std::memory_order_relaxed));
+  ids[1u] = Napi::Number::New(info.Env(),
+                              slot->count.load(std::memory_order_relaxed));
+  return ids;
+}
+
+// Allocate the edge IDs of a source file claimed by ClaimEdgeIds. Returns the
+// first ID of the file. If the optional fourth argument is false, the IDs are
+// allocated for a file that couldn't be claimed, without sharing them.
+Napi::Value CommitEdgeIds(const Napi::CallbackInfo &info) {
+  auto *table = TableArg(info);
+  auto filename = info[1].As<Napi::String>().Utf8Value();
+  auto count = info[2].As<Napi::Number>().Uint32Value();
+  if (info.Length() > 3 && !info[3].As<Napi::Boolean>().Value()) {
+    auto first_id = table->next_id.fetch_add(count, std::memory_order_relaxed);
+    return Napi::Number::New(info.Env(), first_id);
+  }
+  auto *slot = FindSlot(table, filename, false, nullptr);
+  if (slot == nullptr ||
+      slot->state.load(std::memory_order_acquire) != kClaimed ||
+      slot->owner.load(std::memory_order_relaxed) != CurrentOwner()) {
+    throw Napi::Error::New(info.Env(),
+                           "Edge IDs of " + filename + " are not claimed");
+  }
+  auto first_id = table->next_id.fetch_add(count, std::memory_order_relaxed);
+  slot->first_id.store(first_id, std::memory_order_relaxed);
+  slot->count.store(count, std::memory_order_relaxed);
+  slot->state.store(kCommitted, std::memory_order_release);
+  return Napi::Number::New(info.Env(), first_id);
+}
@@ -0,0 +1,165 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Monitoring of the V8 heap for the heap exhaustion bug detector.
+//
+// libFuzzer's -rss_limit_mb and malloc hooks don't see the V8 heap, so a
+// leaking fuzz target runs until V8 aborts the process, which loses the input.
+// Instead, V8 calls us when the heap is about to reach its limit, and after
+// every full garbage collection, when the used heap consists of live objects.
+// As both happen during garbage collection, no JS can be run at that point.
+// The findings are passed to the bug detector in a shared array, which reports
+// them at the end of the iteration.
+//
+// The garbage collection hooks are only available through V8's C++ API, so
+// without the V8 headers monitorHeap isn't exported and the bug detector is
+// turned off.
+
+#ifdef JAZZER_V8_API
+
+#include "heap_monitor.h"
+#include "libfuzzer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <v8.h>
+#ifdef _WIN32
+#include <process.h>
+#define GetPID _getpid
+#else
+#include <unistd.h>
+#define GetPID getpid
+#endif
+
+namespace {
+// Layout of the state shared with the bug detector, see heap-exhaustion.ts.
+enum StateIndex {
+  kStatus,
+  kUsedBytes,
+  kLimitBytes,
+  kBaselineBytes,
+  kGrowingGcs,
+  kStateSize,
+};
+
+enum Status {
+  kOk = 0,
+  kNearHeapLimit = 1,
+  kLeak = 2,
+  kReported = 3,
+};
+
+// A leak is reported once the live heap grew in kLeakGcs full garbage
+// collections in a row, by at least kLeakFraction of the heap limit.
+constexpr int kLeakGcs = 8;
+constexpr double kLeakFraction = 0.1;
+// Raise the heap limit by at least this much once it's reached, so that the
+// finding can be reported.
+constexpr size_t kMinHeadroom = 64 << 20;
+
+// The shared state, backed by the array referenced by gStateArray.
+double *gState = nullptr;
+Napi::Reference<Napi::Float64Array> gStateArray;
+
+size_t gLastLiveBytes = SIZE_MAX;
+size_t gBaselineBytes = 0;
+int gGrowingGcs = 0;
+
+double Megabytes(size_t bytes) { return static_cast<double>(bytes >> 20); }
+
+void SampleLiveHeap(v8::Isolate *isolate, v8::GCType, v8::GCCallbackFlags) {
+  if (gState[kStatus] != kOk) {
+    return;
+  }
+  v8::HeapStatistics statistics;
+  isolate->GetHeapStatistics(&statistics);
+  auto live = statistics.used_heap_size();
+  if (live > gLastLiveBytes) {
+    ++gGrowingGcs;
+  } else {
+    gGrowingGcs = 0;
+    gBaselineBytes = live;
+  }
+  gLastLiveBytes = live;
+
+  if (gGrowingGcs >= kLeakGcs &&
+      live - gBaselineBytes >=
+          kLeakFraction * static_cast<double>(statistics.heap_size_limit())) {
+    gState[kUsedBytes] = static_cast<double>(live);
+    gState[kLimitBytes] = static_cast<double>(statistics.heap_size_limit());
+    gState[kBaselineBytes] = static_cast<double>(gBaselineBytes);
+    gState[kGrowingGcs] = gGrowingGcs;
+    gState[kStatus] = kLeak;
+  }
+}
+
+size_t NearHeapLimit(void *, size_t current_heap_limit,
+                     size_t initial_heap_limit) {
+  if (gState[kStatus] == kNearHeapLimit) {
+    // The iteration kept on allocating after the limit was raised, so it
+    // doesn't end and the bug detector can't report the finding. Report it
+    // here instead, like a segfault, before V8 aborts the process.
+    std::cerr << "==" << (unsigned long)GetPID()
+              << "== Out of Memory: the JavaScript heap reached its limit of "
+              << Megabytes(initial_heap_limit) << " MB" << std::endl;
+    // The callback is only registered by libFuzzer, i.e. not in regression
+    // mode.
+    if (libfuzzer::PrintCrashingInput != nullptr) {
+      libfuzzer::PrintCrashingInput();
+    }
+    _Exit(libfuzzer::EXIT_ERROR_CODE);
+  }
+  if (gState[kStatus] == kReported) {
+    // The limit is only raised once per finding, so that the heap doesn't
+    // keep on growing if the process goes on after the report.
+    return current_heap_limit;
+  }
+  gState[kLimitBytes] = static_cast<double>(initial_heap_limit);
+  gState[kStatus] = kNearHeapLimit;
+  return current_heap_limit + std::max(initial_heap_limit / 4, kMinHeadroom);
+}
+} // namespace
+
+// Start monitoring the heap, the findings are passed on in the given
+// Float64Array. Its data pointer stays valid as Node-API moves the contents of
+// typed arrays allocated on the V8 heap out of it when they are accessed.
+void MonitorHeap(const Napi::CallbackInfo &info) {
+  if (info.Length() != 1 || !info[0].IsTypedArray()) {
+    throw Napi::Error::New(info.Env(), "Need one argument: the state");
+  }
+  auto state = info[0].As<Napi::TypedArray>();
+  if (state.TypedArrayType() != napi_float64_array ||
+      state.ElementLength() != kStateSize) {
+    throw Napi::Error::New(info.Env(), "Expected a Float64Array as state");
+  }
+
+  // The bug detector is loaded again e.g. for every test file in Jest, the
+  // latest state replaces the previous one.
+  auto is_monitored = gState != nullptr;
+  gStateArray = Napi::Persistent(info[0].As<Napi::Float64Array>());
+  // The reference lives as long as the process, it must not be deleted after
+  // the environment is torn down.
+  gStateArray.SuppressDestruct();
+  gState = gStateArray.Value().Data();
+  if (!is_monitored) {
+    auto *isolate = v8::Isolate::GetCurrent();
+    isolate->AddGCEpilogueCallback(SampleLiveHeap,
+                                   v8::kGCTypeMarkSweepCompact);
+    isolate->AddNearHeapLimitCallback(NearHeapLimit, nullptr);
+  }
+}
+
+#endif // JAZZER_V8_API
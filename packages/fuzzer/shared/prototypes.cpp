@@ -0,0 +1,190 @@
+// Copyright 2026 Code Intelligence GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Fingerprints of the prototypes watched by the prototype pollution bug
+// detector, which are compared after every fuzzer iteration.
+//
+// The fingerprint covers the identity of the prototype and the names and
+// values of its own properties, like the snapshots of the bug detector, but
+// doesn't keep any JS objects alive in JS. Primitive values are represented by
+// their content. Node-API doesn't expose the identity of objects, so every
+// object seen at a position of a prototype is kept in a reference and
+// represented by a number that only changes once another object is seen there.
+//
+// The check isn't free of allocations: Object.getOwnPropertyNames creates an
+// array of the names of every prototype, and reading the values creates
+// handles. Strings are hashed in a reused buffer, though.
+
+#include "prototypes.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+// The identity of the object last seen at a position.
+struct Slot {
+  Napi::Reference<Napi::Value> object;
+  uint64_t identity = 0;
+  // Hash of the name of the property last seen at the position, and whether
+  // reading it threw, e.g. for the accessors of Function.prototype.caller.
+  // Such properties are not read again as long as their name stays the same,
+  // as every throw creates an error object.
+  uint64_t name = 0;
+  bool throws = false;
+};
+
+// Slots of the prototype and of its properties, per watched object.
+std::vector<std::vector<Slot>> gSlots;
+uint64_t gNextIdentity = 1;
+
+void Mix(uint64_t &hash, uint64_t value) {
+  hash ^= value;
+  hash *= 0x100000001b3;
+}
+
+uint64_t Identity(Slot &slot, Napi::Value object) {
+  if (slot.object.IsEmpty() || !slot.object.Value().StrictEquals(object)) {
+    slot.object = Napi::Persistent(object);
+    // The references live as long as the process, they must not be deleted
+    // after the environment is torn down.
+    slot.object.SuppressDestruct();
+    slot.identity = gNextIdentity++;
+  }
+  return slot.identity;
+}
+
+uint64_t StringHash(Napi::String string) {
+  // Grows to the longest string seen, instead of allocating a new one for
+  // every string.
+  thread_local std::vector<char16_t> buffer;
+  size_t length = 0;
+  napi_get_value_string_utf16(string.Env(), string, nullptr, 0, &length);
+  if (buffer.size() < length + 1) {
+    buffer.resize(length + 1);
+  }
+  napi_get_value_string_utf16(string.Env(), string, buffer.data(),
+                              buffer.size(), &length);
+  uint64_t hash = 0xcbf29ce484222325;
+  for (size_t i = 0; i < length; ++i) {
+    Mix(hash, buffer[i]);
+  }
+  return hash;
+}
+
+uint64_t ValueHash(Slot &slot, Napi::Value value) {
+  switch (value.Type()) {
+  case napi_object:
+  case napi_function:
+    return Identity(slot, value);
+  case napi_string:
+    return StringHash(value.As<Napi::String>());
+  case napi_number: {
+    double number = value.As<Napi::Number>().DoubleValue();
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    return bits;
+  }
+  case napi_boolean:
+    return value.As<Napi::Boolean>().Value() ? 1 : 2;
+  case napi_null:
+    return 3;
+  default:
+    return 4;
+  }
+}
+
+void MixPrototype(uint64_t &hash, std::vector<Slot> &slots,
+                  Napi::Function get_own_property_names, Napi::Value value) {
+  Napi::Object object;
+  try {
+    // Primitives are fingerprinted by the prototype of their wrapper.
+    object = value.ToObject();
+  } catch (const Napi::Error &) {
+    Mix(hash, 0);
+    return;
+  }
+  napi_value prototype_value;
+  if (napi_get_prototype(object.Env(), object, &prototype_value) != napi_ok) {
+    // E.g. the getPrototypeOf trap of a proxy threw.
+    napi_value exception;
+    napi_get_and_clear_last_exception(object.Env(), &exception);
+    Mix(hash, 0);
+    return;
+  }
+  auto prototype = Napi::Value(object.Env(), prototype_value);
+  if (slots.empty()) {
+    slots.resize(1);
+  }
+  Mix(hash, ValueHash(slots[0], prototype));
+  if (!prototype.IsObject()) {
+    return;
+  }
+
+  Napi::Array names;
+  try {
+    names = get_own_property_names.Call({prototype}).As<Napi::Array>();
+  } catch (const Napi::Error &) {
+    Mix(hash, 0);
+    return;
+  }
+  auto length = names.Length();
+  if (slots.size() < length + 1) {
+    slots.resize(length + 1);
+  }
+  Mix(hash, length);
+  auto properties = prototype.As<Napi::Object>();
+  for (uint32_t i = 0; i < length; ++i) {
+    auto name = names.Get(i);
+    auto name_hash = StringHash(name.As<Napi::String>());
+    Mix(hash, name_hash);
+    auto &slot = slots[i + 1];
+    if (slot.name != name_hash) {
+      slot.name = name_hash;
+      slot.throws = false;
+    }
+    if (slot.throws) {
+      Mix(hash, 0);
+      continue;
+    }
+    try {
+      Mix(hash, ValueHash(slot, properties.Get(name)));
+    } catch (const Napi::Error &) {
+      slot.throws = true;
+      Mix(hash, 0);
+    }
+  }
+}
+} // namespace
+
+// Compute a fingerprint of the prototypes of the given objects. The result is
+// an integer that fits into a JS number exactly.
+Napi::Value FingerprintPrototypes(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto get_own_property_names = env.Global()
+                                    .Get("Object")
+                                    .As<Napi::Object>()
+                                    .Get("getOwnPropertyNames")
+                                    .As<Napi::Function>();
+
+  auto objects = info[0].As<Napi::Array>();
+  if (gSlots.size() < objects.Length()) {
+    gSlots.resize(objects.Length());
+  }
+  uint64_t hash = 0xcbf29ce484222325;
+  for (uint32_t i = 0; i < objects.Length(); ++i) {
+    MixPrototype(hash, gSlots[i], get_own_property_names, objects.Get(i));
+  }
+  return Napi::Number::New(env, static_cast<double>(hash >> 12));
+}
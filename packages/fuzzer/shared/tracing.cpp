@@ -14,6 +14,17 @@
 
 #include "tracing.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // We expect these symbols to exist in the current plugin, provided either by
 // libfuzzer or by the native agent.
 extern "C" {
@@ -21,11 +32,222 @@ void __sanitizer_weak_hook_strcmp(void *called_pc, const char *s1,
                                   const char *s2, int result);
 void __sanitizer_weak_hook_strstr(void *called_pc, const char *s1,
                                   const char *s2, const char *result);
+void __sanitizer_weak_hook_memcmp(void *called_pc, const void *s1,
+                                  const void *s2, size_t n, int result);
+void __sanitizer_weak_hook_memmem(void *called_pc, const void *s1, size_t len1,
+                                  const void *s2, size_t len2, void *result);
 void __sanitizer_cov_trace_const_cmp8_with_pc(uintptr_t called_pc,
                                               uint64_t arg1, uint64_t arg2);
 void __sanitizer_cov_trace_pc_indir_with_pc(void *caller_pc, uintptr_t callee);
+
+#ifndef _WIN32
+// The 4-byte compare hook is weak, so that runtimes only providing the 8-byte
+// variant keep working.
+__attribute__((weak)) void
+__sanitizer_cov_trace_const_cmp4_with_pc(uintptr_t called_pc, uint32_t arg1,
+                                         uint32_t arg2);
+#endif
+}
+
+namespace {
+// Kinds of compare events recorded in the trace buffer, keep in sync with
+// `EventKind` in traceBuffer.ts.
+enum EventKind : int {
+  kIntegerCompare = 0,
+  kUnequalStrings = 1,
+  kStringContainment = 2,
+  kFloatCompare = 3,
+  kBigIntCompare = 4,
+  kSwitch = 5,
+};
+
+// Layout of the trace buffer's state and records, keep in sync with
+// traceBuffer.ts.
+const std::size_t kStateCount = 0;
+const std::size_t kStateEpoch = 1;
+const std::size_t kRecordSize = 4;
+
+// Compare events recorded from JavaScript in memory shared with the addon. The
+// records are numbers for integer compares; for string compares, the strings
+// are kept in a JS array and only referenced from the records. The operands of
+// the JS tracer's cache of recent events are shared as well, so that the
+// strings in there can be released along with the drained events. The epoch,
+// kind and ID of the cached events tell whether a slot still holds the drained
+// event.
+struct TraceBuffer {
+  Napi::Reference<Napi::Uint32Array> state;
+  Napi::Reference<Napi::Float64Array> records;
+  Napi::Reference<Napi::Array> strings;
+  Napi::Reference<Napi::Uint32Array> seen_epoch;
+  Napi::Reference<Napi::Uint8Array> seen_kind;
+  Napi::Reference<Napi::Float64Array> seen_id;
+  Napi::Reference<Napi::Array> operands;
+};
+
+// Every JS thread, e.g. a Jest worker thread, registers its own buffer.
+thread_local std::optional<TraceBuffer> gTraceBuffer;
+
+// JS numbers can exceed the range of int64_t, saturate instead of invoking
+// undefined behavior on conversion.
+int64_t ToInt64(double value) {
+  if (value >= 9223372036854775807.0) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  if (value <= -9223372036854775808.0) {
+    return std::numeric_limits<int64_t>::min();
+  }
+  return static_cast<int64_t>(value);
+}
+
+// Report a comparison with a constant as a 4-byte compare if both operands fit
+// into 32 bits, as an 8-byte compare otherwise. libfuzzer only keeps tables of
+// compared 4 and 8 byte values for its mutations, narrower compares only feed
+// the value profile. So small constants, e.g. opcodes or the 16-bit 0xFFD8
+// marker of JPEG files, must be reported with 4 bytes to be inserted into the
+// input at all.
+void TraceConstCompare(uintptr_t id, uint64_t arg1, uint64_t arg2) {
+#ifndef _WIN32
+  if ((arg1 | arg2) <= std::numeric_limits<uint32_t>::max() &&
+      __sanitizer_cov_trace_const_cmp4_with_pc) {
+    __sanitizer_cov_trace_const_cmp4_with_pc(id, arg1, arg2);
+    return;
+  }
+#endif
+  __sanitizer_cov_trace_const_cmp8_with_pc(id, arg1, arg2);
+}
+
+// Floating-point numbers are compared by their representation, which is
+// what ends up in binary inputs.
+uint64_t DoubleBits(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Case values of the instrumented switch statements, sorted as unsigned
+// 64-bit integers. Registered when a module is loaded and looked up by index
+// from the trace buffer, on the same thread.
+thread_local std::vector<std::vector<uint64_t>> gSwitchCases;
+
+// Index of the case table of each switch statement, keyed by its file and
+// site, so that modules evaluated more than once, e.g. by Jest for every
+// test file, reuse their tables instead of adding new ones.
+thread_local std::unordered_map<std::string, std::size_t> gSwitchTables;
+
+// The ID of the compare with the next larger case. The fake PCs of the
+// instrumentation are random, so `id + 1` could well be the ID of another
+// compare; hashing in the table keeps the two apart.
+uintptr_t UpperCaseId(uintptr_t id, std::size_t table) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (uint64_t value : {static_cast<uint64_t>(id), uint64_t{table}}) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xff;
+      hash *= 0x100000001b3;
+    }
+  }
+  return static_cast<uintptr_t>(hash);
 }
 
+// Like libfuzzer's __sanitizer_cov_trace_switch, compare the switch value
+// with the next smaller and the next larger case, at distinct IDs. Values
+// matching a case have nothing to learn from.
+void TraceSwitch(uintptr_t id, uint64_t value, std::size_t table) {
+  if (table >= gSwitchCases.size()) {
+    return;
+  }
+  const auto &cases = gSwitchCases[table];
+  auto larger = std::upper_bound(cases.begin(), cases.end(), value);
+  if (larger != cases.begin()) {
+    if (*(larger - 1) == value) {
+      return;
+    }
+    TraceConstCompare(id, value, *(larger - 1));
+  }
+  if (larger != cases.end()) {
+    TraceConstCompare(UpperCaseId(id, table), value, *larger);
+  }
+}
+
+// libfuzzer only looks at the first 64 bytes of compared strings (see
+// `Word::kMaxSize` in FuzzerDictionary.h), anything beyond that is not worth
+// decoding.
+const std::size_t kStringWindowSize = 64;
+
+// Scratch space for the operands of a string comparison. Thread-local, as the
+// addon may be loaded in multiple threads, e.g. in worker threads.
+using StringWindow = std::array<char, kStringWindowSize + 1>;
+thread_local StringWindow gWindow1;
+thread_local StringWindow gWindow2;
+
+// Decode the start of a JS string into the given window and return it as
+// null-terminated UTF-8 string. Only the part that fits into the window is
+// transcoded, so that the cost does not depend on the length of the string.
+const char *ReadStringWindow(const Napi::Value &value, StringWindow &window) {
+  std::size_t length;
+  auto status = napi_get_value_string_utf8(value.Env(), value, window.data(),
+                                           window.size(), &length);
+  if (status != napi_ok) {
+    throw Napi::Error::New(value.Env());
+  }
+  return window.data();
+}
+
+// The bytes backing a Buffer, typed array, DataView or ArrayBuffer.
+struct Bytes {
+  const void *data = nullptr;
+  std::size_t length = 0;
+};
+
+std::size_t ElementSize(napi_typedarray_type type) {
+  switch (type) {
+  case napi_int16_array:
+  case napi_uint16_array:
+    return 2;
+  case napi_int32_array:
+  case napi_uint32_array:
+  case napi_float32_array:
+    return 4;
+  case napi_float64_array:
+  case napi_bigint64_array:
+  case napi_biguint64_array:
+    return 8;
+  default:
+    return 1;
+  }
+}
+
+// Get the bytes of the given value without copying them. They are only valid
+// until control returns to JS.
+std::optional<Bytes> ReadBytes(const Napi::Value &value) {
+  napi_env env = value.Env();
+  Bytes bytes;
+  void *data = nullptr;
+  if (value.IsTypedArray()) {
+    napi_typedarray_type type;
+    std::size_t length;
+    if (napi_get_typedarray_info(env, value, &type, &length, &data, nullptr,
+                                 nullptr) != napi_ok) {
+      return std::nullopt;
+    }
+    bytes.length = length * ElementSize(type);
+  } else if (value.IsDataView()) {
+    if (napi_get_dataview_info(env, value, &bytes.length, &data, nullptr,
+                               nullptr) != napi_ok) {
+      return std::nullopt;
+    }
+  } else if (value.IsArrayBuffer()) {
+    if (napi_get_arraybuffer_info(env, value, &data, &bytes.length) !=
+        napi_ok) {
+      return std::nullopt;
+    }
+  } else {
+    return std::nullopt;
+  }
+  bytes.data = data;
+  return bytes;
+}
+} // namespace
+
 // Record a comparison between two strings in the target that returned unequal.
 void TraceUnequalStrings(const Napi::CallbackInfo &info) {
   if (info.Length() != 3) {
@@ -35,12 +257,12 @@ void TraceUnequalStrings(const Napi::CallbackInfo &info) {
   }
 
   auto id = info[0].As<Napi::Number>().Int64Value();
-  auto s1 = info[1].As<Napi::String>().Utf8Value();
-  auto s2 = info[2].As<Napi::String>().Utf8Value();
+  auto s1 = ReadStringWindow(info[1], gWindow1);
+  auto s2 = ReadStringWindow(info[2], gWindow2);
 
   // strcmp returns zero on equality, and libfuzzer doesn't care about the
   // result beyond whether it's zero or not.
-  __sanitizer_weak_hook_strcmp((void *)id, s1.c_str(), s2.c_str(), 1);
+  __sanitizer_weak_hook_strcmp((void *)id, s1, s2, 1);
 }
 
 // Record a substring check to find the first occurrence of the byte string
@@ -52,14 +274,59 @@ void TraceStringContainment(const Napi::CallbackInfo &info) {
   }
 
   auto id = info[0].As<Napi::Number>().Int64Value();
-  auto needle = info[1].As<Napi::String>().Utf8Value();
-  auto haystack = info[2].As<Napi::String>().Utf8Value();
+  auto needle = ReadStringWindow(info[1], gWindow1);
+  auto haystack = ReadStringWindow(info[2], gWindow2);
 
   // libFuzzer currently ignores the result, which allows us to simply pass a
   // valid but arbitrary pointer here instead of performing an actual strstr
   // operation.
-  __sanitizer_weak_hook_strstr((void *)id, needle.c_str(), haystack.c_str(),
-                               needle.c_str());
+  __sanitizer_weak_hook_strstr((void *)id, needle, haystack, needle);
+}
+
+// Record a comparison between two byte sequences in the target that returned
+// unequal, e.g. of two Buffers. The bytes are passed to libfuzzer in place.
+void TraceUnequalBytes(const Napi::CallbackInfo &info) {
+  if (info.Length() != 3) {
+    throw Napi::Error::New(info.Env(),
+                           "Need three arguments: the trace ID and the two "
+                           "compared byte sequences");
+  }
+
+  auto id = info[0].As<Napi::Number>().Int64Value();
+  auto b1 = ReadBytes(info[1]);
+  auto b2 = ReadBytes(info[2]);
+  if (!b1 || !b2) {
+    return;
+  }
+  // Like for strings, only equality matters to libfuzzer.
+  __sanitizer_weak_hook_memcmp((void *)id, b1->data, b2->data,
+                               std::min(b1->length, b2->length), 1);
+  // The compare above only covers the common prefix. If the target, i.e. the
+  // second sequence, is longer, it's passed on in full as well, as if it was
+  // searched for in the first one, so that libfuzzer can insert all of it.
+  if (b2->length > b1->length) {
+    __sanitizer_weak_hook_memmem((void *)id, b1->data, b1->length, b2->data,
+                                 b2->length, nullptr);
+  }
+}
+
+// Record a search for the byte sequence needle in the byte sequence haystack,
+// e.g. by Buffer.indexOf, that did not find it.
+void TraceBytesContainment(const Napi::CallbackInfo &info) {
+  if (info.Length() != 3) {
+    throw Napi::Error::New(info.Env(),
+                           "Need three arguments: the trace ID and the two "
+                           "byte sequences");
+  }
+
+  auto id = info[0].As<Napi::Number>().Int64Value();
+  auto needle = ReadBytes(info[1]);
+  auto haystack = ReadBytes(info[2]);
+  if (!needle || !haystack || needle->length == 0) {
+    return;
+  }
+  __sanitizer_weak_hook_memmem((void *)id, haystack->data, haystack->length,
+                               needle->data, needle->length, nullptr);
 }
 
 void TraceIntegerCompare(const Napi::CallbackInfo &info) {
@@ -72,7 +339,39 @@ void TraceIntegerCompare(const Napi::CallbackInfo &info) {
   auto id = info[0].As<Napi::Number>().Int64Value();
   auto arg1 = info[1].As<Napi::Number>().Int64Value();
   auto arg2 = info[2].As<Napi::Number>().Int64Value();
-  __sanitizer_cov_trace_const_cmp8_with_pc(id, arg1, arg2);
+  TraceConstCompare(id, arg1, arg2);
+}
+
+// Register the integer cases of the switch statement at the given site of a
+// file, returns the index of the case table to pass along with the traced
+// switch values. Registering the same site again replaces its cases, in case
+// the file changed, and returns the same index.
+Napi::Value RegisterSwitchCases(const Napi::CallbackInfo &info) {
+  if (info.Length() != 3 || !info[0].IsString() || !info[1].IsNumber() ||
+      !info[2].IsArray()) {
+    throw Napi::Error::New(info.Env(),
+                           "Need three arguments: the file name, the site of "
+                           "the switch in the file and the case values");
+  }
+
+  auto key = info[0].As<Napi::String>().Utf8Value();
+  key.push_back('\0');
+  key += std::to_string(info[1].As<Napi::Number>().Int64Value());
+  auto values = info[2].As<Napi::Array>();
+  std::vector<uint64_t> cases;
+  cases.reserve(values.Length());
+  for (uint32_t i = 0; i < values.Length(); ++i) {
+    cases.push_back(ToInt64(values.Get(i).As<Napi::Number>().DoubleValue()));
+  }
+  std::sort(cases.begin(), cases.end());
+  cases.erase(std::unique(cases.begin(), cases.end()), cases.end());
+  auto [table, added] = gSwitchTables.emplace(key, gSwitchCases.size());
+  if (added) {
+    gSwitchCases.push_back(std::move(cases));
+  } else {
+    gSwitchCases[table->second] = std::move(cases);
+  }
+  return Napi::Number::New(info.Env(), static_cast<double>(table->second));
 }
 
 void TracePcIndir(const Napi::CallbackInfo &info) {
@@ -85,3 +384,146 @@ void TracePcIndir(const Napi::CallbackInfo &info) {
   auto state = info[1].As<Napi::Number>().Int64Value();
   __sanitizer_cov_trace_pc_indir_with_pc((void *)id, state);
 }
+
+// Register the trace buffer filled by the JS tracer. Compare events are
+// recorded there instead of calling into the addon for each of them, and are
+// passed on to libfuzzer by DrainTraceBuffer.
+void RegisterTraceBuffer(const Napi::CallbackInfo &info) {
+  if (info.Length() != 7 || !info[0].IsTypedArray() ||
+      !info[1].IsTypedArray() || !info[2].IsArray() ||
+      !info[3].IsTypedArray() || !info[4].IsTypedArray() ||
+      !info[5].IsTypedArray() || !info[6].IsArray()) {
+    throw Napi::Error::New(info.Env(),
+                           "Need seven arguments: the state, the records and "
+                           "the strings of the trace buffer, and the epochs, "
+                           "kinds, IDs and operands of its cached events");
+  }
+
+  auto state = info[0].As<Napi::TypedArray>();
+  auto records = info[1].As<Napi::TypedArray>();
+  if (state.TypedArrayType() != napi_uint32_array || state.ElementLength() < 2) {
+    throw Napi::Error::New(info.Env(), "Expected a Uint32Array as state");
+  }
+  if (records.TypedArrayType() != napi_float64_array ||
+      records.ElementLength() % kRecordSize != 0) {
+    throw Napi::Error::New(info.Env(), "Expected a Float64Array of records");
+  }
+  auto seen_epoch = info[3].As<Napi::TypedArray>();
+  auto seen_kind = info[4].As<Napi::TypedArray>();
+  auto seen_id = info[5].As<Napi::TypedArray>();
+  auto slots = seen_epoch.ElementLength();
+  if (seen_epoch.TypedArrayType() != napi_uint32_array ||
+      seen_kind.TypedArrayType() != napi_uint8_array ||
+      seen_id.TypedArrayType() != napi_float64_array ||
+      seen_kind.ElementLength() != slots || seen_id.ElementLength() != slots ||
+      info[6].As<Napi::Array>().Length() != 2 * slots) {
+    throw Napi::Error::New(info.Env(), "Expected cached events of equal size");
+  }
+
+  gTraceBuffer = {Napi::Persistent(info[0].As<Napi::Uint32Array>()),
+                  Napi::Persistent(info[1].As<Napi::Float64Array>()),
+                  Napi::Persistent(info[2].As<Napi::Array>()),
+                  Napi::Persistent(info[3].As<Napi::Uint32Array>()),
+                  Napi::Persistent(info[4].As<Napi::Uint8Array>()),
+                  Napi::Persistent(info[5].As<Napi::Float64Array>()),
+                  Napi::Persistent(info[6].As<Napi::Array>())};
+  // The references live as long as the thread, they must not be deleted after
+  // its environment is torn down.
+  gTraceBuffer->state.SuppressDestruct();
+  gTraceBuffer->records.SuppressDestruct();
+  gTraceBuffer->strings.SuppressDestruct();
+  gTraceBuffer->seen_epoch.SuppressDestruct();
+  gTraceBuffer->seen_kind.SuppressDestruct();
+  gTraceBuffer->seen_id.SuppressDestruct();
+  gTraceBuffer->operands.SuppressDestruct();
+}
+
+// Pass all compare events recorded in the trace buffer on to libfuzzer. Called
+// from JS if the buffer is full.
+void FlushTraceBuffer(const Napi::CallbackInfo &info) {
+  DrainTraceBuffer(info.Env(), false);
+}
+
+void DrainTraceBuffer(Napi::Env env, bool end_of_iteration) {
+  if (!gTraceBuffer) {
+    return;
+  }
+  auto scope = Napi::HandleScope(env);
+
+  auto state = gTraceBuffer->state.Value();
+  auto records = gTraceBuffer->records.Value();
+  auto capacity = records.ElementLength() / kRecordSize;
+  auto count = std::min<std::size_t>(state[kStateCount], capacity);
+  auto strings = gTraceBuffer->strings.Value();
+  auto seen_epoch = gTraceBuffer->seen_epoch.Value();
+  auto seen_kind = gTraceBuffer->seen_kind.Value();
+  auto seen_id = gTraceBuffer->seen_id.Value();
+  auto operands = gTraceBuffer->operands.Value();
+  // Drained strings are replaced, so that they don't keep old inputs alive. In
+  // the cache of recent events, the entry of a string compare is dropped, too,
+  // i.e. it may be recorded once more if the buffer was flushed during the
+  // iteration. A later event may have taken over the slot since, its operands
+  // are kept, as resetting them would make the cache skip that event's next
+  // occurrence with zero operands.
+  auto release = [&, empty = Napi::String::New(env, ""),
+                  none = Napi::Number::New(env, 0)](std::size_t i,
+                                                    const double *record) {
+    auto slot = static_cast<uint32_t>(record[2]);
+    strings.Set(static_cast<uint32_t>(2 * i), empty);
+    strings.Set(static_cast<uint32_t>(2 * i + 1), empty);
+    if (slot < seen_epoch.ElementLength() &&
+        seen_epoch[slot] == state[kStateEpoch] &&
+        seen_kind[slot] == static_cast<uint8_t>(record[0]) &&
+        seen_id[slot] == record[1]) {
+      operands.Set(2 * slot, none);
+      operands.Set(2 * slot + 1, none);
+    }
+  };
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const double *record = records.Data() + i * kRecordSize;
+    auto id = ToInt64(record[1]);
+    switch (static_cast<int>(record[0])) {
+    case kIntegerCompare:
+      TraceConstCompare(id, ToInt64(record[2]), ToInt64(record[3]));
+      break;
+    case kFloatCompare:
+      __sanitizer_cov_trace_const_cmp8_with_pc(id, DoubleBits(record[2]),
+                                               DoubleBits(record[3]));
+      break;
+    case kBigIntCompare: {
+      // The operands are passed as hexadecimal strings of their lower 64 bits.
+      auto n1 = ReadStringWindow(strings.Get(2 * i), gWindow1);
+      auto n2 = ReadStringWindow(strings.Get(2 * i + 1), gWindow2);
+      TraceConstCompare(id, std::strtoull(n1, nullptr, 16),
+                        std::strtoull(n2, nullptr, 16));
+      release(i, record);
+      break;
+    }
+    case kSwitch:
+      TraceSwitch(id, ToInt64(record[3]), static_cast<std::size_t>(record[2]));
+      break;
+    case kUnequalStrings: {
+      auto s1 = ReadStringWindow(strings.Get(2 * i), gWindow1);
+      auto s2 = ReadStringWindow(strings.Get(2 * i + 1), gWindow2);
+      __sanitizer_weak_hook_strcmp((void *)id, s1, s2, 1);
+      release(i, record);
+      break;
+    }
+    case kStringContainment: {
+      auto needle = ReadStringWindow(strings.Get(2 * i), gWindow1);
+      auto haystack = ReadStringWindow(strings.Get(2 * i + 1), gWindow2);
+      __sanitizer_weak_hook_strstr((void *)id, needle, haystack, needle);
+      release(i, record);
+      break;
+    }
+    }
+  }
+
+  state[kStateCount] = 0;
+  // Starting a new epoch lets the JS tracer record events again that it
+  // skipped as duplicates during the finished iteration.
+  if (end_of_iteration) {
+    state[kStateEpoch] = state[kStateEpoch] + 1;
+  }
+}
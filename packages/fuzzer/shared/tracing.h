@@ -17,5 +17,15 @@
 
 void TraceUnequalStrings(const Napi::CallbackInfo &info);
 void TraceStringContainment(const Napi::CallbackInfo &info);
+void TraceUnequalBytes(const Napi::CallbackInfo &info);
+void TraceBytesContainment(const Napi::CallbackInfo &info);
 void TraceIntegerCompare(const Napi::CallbackInfo &info);
+Napi::Value RegisterSwitchCases(const Napi::CallbackInfo &info);
 void TracePcIndir(const Napi::CallbackInfo &info);
+void RegisterTraceBuffer(const Napi::CallbackInfo &info);
+void FlushTraceBuffer(const Napi::CallbackInfo &info);
+
+// Pass the compare events recorded in the trace buffer on to libfuzzer. Has to
+// be called on the JS thread at the end of each fuzzer iteration, while
+// libfuzzer still considers the fuzz target to be running.
+void DrainTraceBuffer(Napi::Env env, bool end_of_iteration);
@@ -15,6 +15,7 @@
  */
 
 import { addon } from "./addon";
+import { traceBuffer } from "./traceBuffer";
 
 /**
  * Performs a string comparison between two strings and calls the corresponding native hook if needed.
@@ -59,30 +60,57 @@ function traceStrCmp(
 		typeof s1 === "string" &&
 		typeof s2 === "string"
 	) {
-		addon.traceUnequalStrings(id, s1, s2);
+		traceBuffer.traceUnequalStrings(id, s1, s2);
 	}
 	return result;
 }
 
 /**
- * Performs an integer comparison between two strings and calls the corresponding native hook if needed.
+ * Records a comparison of two numbers, integers and floating-point numbers are
+ * passed on separately. A BigInt may be compared with a BigInt or an integer.
+ */
+function traceNumbers(n1: unknown, n2: unknown, id: number) {
+	if (typeof n1 === "number" && typeof n2 === "number") {
+		if (Number.isInteger(n1) && Number.isInteger(n2)) {
+			traceBuffer.traceIntegerCompare(id, n1, n2);
+		} else {
+			traceBuffer.traceFloatCompare(id, n1, n2);
+		}
+	} else if (typeof n1 === "bigint" || typeof n2 === "bigint") {
+		const b1 = toBigInt(n1);
+		const b2 = toBigInt(n2);
+		if (b1 !== undefined && b2 !== undefined) {
+			traceBuffer.traceBigIntCompare(id, b1, b2);
+		}
+	}
+}
+
+function toBigInt(n: unknown): bigint | undefined {
+	if (typeof n === "bigint") {
+		return n;
+	}
+	if (typeof n === "number" && Number.isSafeInteger(n)) {
+		return BigInt(n);
+	}
+}
+
+/**
+ * Performs a number comparison between two numbers and calls the corresponding native hook if needed.
  * This function replaces the original comparison expression and preserves the semantics by returning
  * the original result after calling the native hook.
- * @param n1 first compared number
- * @param n2 second compared number
+ * @param n1 first compared number or BigInt
+ * @param n2 second compared number or BigInt
  * @param operator the operator used in the comparison
  * @param id an unique identifier to distinguish between the different comparisons
  * @returns result of the comparison
  */
 function traceNumberCmp(
-	n1: number,
-	n2: number,
+	n1: number | bigint,
+	n2: number | bigint,
 	operator: string,
 	id: number,
 ): boolean {
-	if (Number.isInteger(n1) && Number.isInteger(n2)) {
-		addon.traceIntegerCompare(id, n1, n2);
-	}
+	traceNumbers(n1, n2, id);
 	switch (operator) {
 		case "==":
 			return n1 == n2;
@@ -108,41 +136,75 @@ function traceNumberCmp(
 function traceAndReturn(current: unknown, target: unknown, id: number) {
 	switch (typeof target) {
 		case "number":
-			if (typeof current === "number") {
-				if (Number.isInteger(current) && Number.isInteger(target)) {
-					addon.traceIntegerCompare(id, current, target);
-				}
-			}
+		case "bigint":
+			traceNumbers(current, target, id);
 			break;
 		case "string":
 			if (typeof current === "string") {
-				addon.traceUnequalStrings(id, current, target);
+				traceBuffer.traceUnequalStrings(id, current, target);
 			}
 	}
 	return target;
 }
 
+/**
+ * Registers the integer cases of the switch statement at the given site of a
+ * file once, when the instrumented module is loaded, and returns the index of
+ * the case table. Evaluating the module again reuses the table.
+ */
+function switchCases(filename: string, site: number, cases: number[]): number {
+	return addon.registerSwitchCases(filename, site, cases);
+}
+
+/**
+ * Records the value of a switch statement with the case table registered by
+ * {@link switchCases}, so that the value is compared with the nearest cases
+ * instead of with every single one. Returns the value to switch on.
+ */
+function traceSwitch(value: unknown, table: number | undefined, id: number) {
+	// The table is undefined if the switch runs before the module registered
+	// its cases, e.g. in a function called during a circular import.
+	if (
+		table !== undefined &&
+		typeof value === "number" &&
+		Number.isInteger(value)
+	) {
+		traceBuffer.traceSwitch(id, table, value);
+	}
+	return value;
+}
+
 export interface Tracer {
 	traceStrCmp: typeof traceStrCmp;
-	traceUnequalStrings: typeof addon.traceUnequalStrings;
-	traceStringContainment: typeof addon.traceStringContainment;
+	traceUnequalStrings: typeof traceBuffer.traceUnequalStrings;
+	traceStringContainment: typeof traceBuffer.traceStringContainment;
 	traceNumberCmp: typeof traceNumberCmp;
 	traceAndReturn: typeof traceAndReturn;
+	switchCases: typeof switchCases;
+	traceSwitch: typeof traceSwitch;
 	tracePcIndir: typeof addon.tracePcIndir;
 	guideTowardsEquality: typeof guideTowardsEquality;
 	guideTowardsContainment: typeof guideTowardsContainment;
+	guideTowardsEqualBytes: typeof guideTowardsEqualBytes;
+	guideTowardsBytesContainment: typeof guideTowardsBytesContainment;
 	exploreState: typeof exploreState;
 }
 
 export const tracer: Tracer = {
 	traceStrCmp,
-	traceUnequalStrings: addon.traceUnequalStrings,
-	traceStringContainment: addon.traceStringContainment,
+	traceUnequalStrings: (id, s1, s2) =>
+		traceBuffer.traceUnequalStrings(id, s1, s2),
+	traceStringContainment: (id, needle, haystack) =>
+		traceBuffer.traceStringContainment(id, needle, haystack),
 	traceNumberCmp,
 	traceAndReturn,
+	switchCases,
+	traceSwitch,
 	tracePcIndir: addon.tracePcIndir,
 	guideTowardsEquality: guideTowardsEquality,
 	guideTowardsContainment: guideTowardsContainment,
+	guideTowardsEqualBytes: guideTowardsEqualBytes,
+	guideTowardsBytesContainment: guideTowardsBytesContainment,
 	exploreState: exploreState,
 };
 
@@ -195,6 +257,56 @@ function guideTowardsContainment(needle: string, haystack: string, id: number) {
 	tracer.traceStringContainment(id, needle, haystack);
 }
 
+/**
+ * Instructs the fuzzer to guide its mutations towards making the bytes of `current` equal to the
+ * bytes of `target`, e.g. after comparing two Buffers.
+ *
+ * The bytes are passed to the fuzzer without copying them.
+ *
+ * @param current a non-constant Buffer, typed array, DataView or ArrayBuffer observed during fuzz
+ *     target execution
+ * @param target a byte sequence that `current` should become equal to, but currently isn't
+ * @param id a (probabilistically) unique identifier for this particular compare hint
+ */
+function guideTowardsEqualBytes(
+	current: ArrayBufferView | ArrayBuffer,
+	target: ArrayBufferView | ArrayBuffer,
+	id: number,
+) {
+	// Check types as JavaScript fuzz targets could provide wrong ones.
+	if (!isBytes(current) || !isBytes(target) || typeof id !== "number") {
+		return;
+	}
+	addon.traceUnequalBytes(id, current, target);
+}
+
+/**
+ * Instructs the fuzzer to guide its mutations towards making `haystack` contain the bytes of
+ * `needle`, e.g. after searching a Buffer with `indexOf`.
+ *
+ * The bytes are passed to the fuzzer without copying them.
+ *
+ * @param needle a byte sequence that should be contained in `haystack`, but currently isn't
+ * @param haystack a non-constant Buffer, typed array, DataView or ArrayBuffer observed during
+ *     fuzz target execution
+ * @param id a (probabilistically) unique identifier for this particular compare hint
+ */
+function guideTowardsBytesContainment(
+	needle: ArrayBufferView | ArrayBuffer,
+	haystack: ArrayBufferView | ArrayBuffer,
+	id: number,
+) {
+	// Check types as JavaScript fuzz targets could provide wrong ones.
+	if (!isBytes(needle) || !isBytes(haystack) || typeof id !== "number") {
+		return;
+	}
+	addon.traceBytesContainment(id, needle, haystack);
+}
+
+function isBytes(value: unknown): value is ArrayBufferView | ArrayBuffer {
+	return ArrayBuffer.isView(value) || value instanceof ArrayBuffer;
+}
+
 /**
  * Instructs the fuzzer to attain as many possible values for the absolute value of `state`
  * as possible.
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import { addon } from "./addon";
+
+// Kinds of recorded compare events, keep in sync with shared/tracing.cpp.
+const enum EventKind {
+	IntegerCompare = 0,
+	UnequalStrings = 1,
+	StringContainment = 2,
+	FloatCompare = 3,
+	BigIntCompare = 4,
+	Switch = 5,
+}
+
+// Indices into the state shared with the addon.
+const STATE_COUNT = 0;
+const STATE_EPOCH = 1;
+
+// Each record consists of the event kind, the trace ID and two operands. Events
+// with string operands store the slot of the event in the cache of recent
+// events instead, so that the addon can release the strings in there.
+const RECORD_SIZE = 4;
+
+/**
+ * Records compare events in memory shared with the native addon instead of
+ * calling into the addon for every single comparison.
+ *
+ * The addon passes the recorded events on to libFuzzer at the end of each
+ * fuzzer iteration, or earlier if the buffer is full. Events that occur
+ * multiple times with the same operands at the same site during one iteration
+ * are only recorded once, as libFuzzer would not learn anything new from them.
+ */
+export class TraceBuffer {
+	private static readonly CAPACITY: number = 1 << 12;
+	private static readonly DEDUP_SLOTS: number = 1 << 12;
+
+	// Number of recorded events and the current epoch, which the addon
+	// advances at the end of each fuzzer iteration.
+	private readonly state = new Uint32Array(2);
+	private readonly records = new Float64Array(
+		TraceBuffer.CAPACITY * RECORD_SIZE,
+	);
+	// Compared strings of the event at index i are stored at 2 * i and 2 * i + 1,
+	// as are the compared BigInts, encoded as hexadecimal strings.
+	private readonly strings: string[] = Array(2 * TraceBuffer.CAPACITY).fill("");
+
+	// Direct-mapped cache of the last event per slot, used to skip duplicates.
+	private readonly seenEpoch = new Uint32Array(TraceBuffer.DEDUP_SLOTS);
+	private readonly seenKind = new Uint8Array(TraceBuffer.DEDUP_SLOTS);
+	private readonly seenId = new Float64Array(TraceBuffer.DEDUP_SLOTS);
+	private readonly seenOperands: unknown[] = Array(
+		2 * TraceBuffer.DEDUP_SLOTS,
+	).fill(0);
+
+	constructor() {
+		// Epoch 0 marks unused cache slots.
+		this.state[STATE_EPOCH] = 1;
+		addon.registerTraceBuffer(
+			this.state,
+			this.records,
+			this.strings,
+			this.seenEpoch,
+			this.seenKind,
+			this.seenId,
+			this.seenOperands,
+		);
+	}
+
+	traceIntegerCompare(id: number, n1: number, n2: number) {
+		const index = this.reserve(EventKind.IntegerCompare, id, n1, n2);
+		if (index >= 0) {
+			this.records[index * RECORD_SIZE + 2] = n1;
+			this.records[index * RECORD_SIZE + 3] = n2;
+		}
+	}
+
+	traceFloatCompare(id: number, n1: number, n2: number) {
+		const index = this.reserve(EventKind.FloatCompare, id, n1, n2);
+		if (index >= 0) {
+			this.records[index * RECORD_SIZE + 2] = n1;
+			this.records[index * RECORD_SIZE + 3] = n2;
+		}
+	}
+
+	traceBigIntCompare(id: number, n1: bigint, n2: bigint) {
+		const index = this.reserve(EventKind.BigIntCompare, id, n1, n2);
+		if (index >= 0) {
+			// Only the lower 64 bits are passed on, like for native integers.
+			this.strings[2 * index] = BigInt.asUintN(64, n1).toString(16);
+			this.strings[2 * index + 1] = BigInt.asUintN(64, n2).toString(16);
+		}
+	}
+
+	/**
+	 * Records the value of a switch statement, whose integer cases were
+	 * registered as the given case table with the addon.
+	 */
+	traceSwitch(id: number, table: number, value: number) {
+		const index = this.reserve(EventKind.Switch, id, table, value);
+		if (index >= 0) {
+			this.records[index * RECORD_SIZE + 2] = table;
+			this.records[index * RECORD_SIZE + 3] = value;
+		}
+	}
+
+	traceUnequalStrings(id: number, s1: string, s2: string) {
+		const index = this.reserve(EventKind.UnequalStrings, id, s1, s2);
+		if (index >= 0) {
+			this.strings[2 * index] = s1;
+			this.strings[2 * index + 1] = s2;
+		}
+	}
+
+	traceStringContainment(id: number, needle: string, haystack: string) {
+		const index = this.reserve(
+			EventKind.StringContainment,
+			id,
+			needle,
+			haystack,
+		);
+		if (index >= 0) {
+			this.strings[2 * index] = needle;
+			this.strings[2 * index + 1] = haystack;
+		}
+	}
+
+	/**
+	 * Reserves a record for the given event and returns its index, or -1 if the
+	 * same event was already recorded in the current iteration.
+	 */
+	private reserve(
+		kind: EventKind,
+		id: number,
+		operand1: unknown,
+		operand2: unknown,
+	): number {
+		const epoch = this.state[STATE_EPOCH];
+		const slot = (id ^ (id >>> 12) ^ kind) & (TraceBuffer.DEDUP_SLOTS - 1);
+		if (
+			this.seenEpoch[slot] === epoch &&
+			this.seenId[slot] === id &&
+			this.seenKind[slot] === kind &&
+			this.seenOperands[2 * slot] === operand1 &&
+			this.seenOperands[2 * slot + 1] === operand2
+		) {
+			return -1;
+		}
+		this.seenEpoch[slot] = epoch;
+		this.seenId[slot] = id;
+		this.seenKind[slot] = kind;
+		this.seenOperands[2 * slot] = operand1;
+		this.seenOperands[2 * slot + 1] = operand2;
+
+		let count = this.state[STATE_COUNT];
+		if (count >= TraceBuffer.CAPACITY) {
+			addon.flushTraceBuffer();
+			count = 0;
+		}
+		this.records[count * RECORD_SIZE] = kind;
+		this.records[count * RECORD_SIZE + 1] = id;
+		this.records[count * RECORD_SIZE + 2] = slot;
+		this.state[STATE_COUNT] = count + 1;
+		return count;
+	}
+}
+
+export const traceBuffer = new TraceBuffer();
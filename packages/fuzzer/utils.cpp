@@ -13,6 +13,7 @@
 //  limitations under the License.
 
 #include "utils.h"
+#include "fuzz_input.h"
 #include "napi.h"
 #include "shared/libfuzzer.h"
 #include <csignal>
@@ -47,6 +48,55 @@ std::vector<std::string> LibFuzzerArgs(Napi::Env env,
   return fuzzer_args;
 }
 
+// Reads the execution options passed in from JS. Options that are not
+// supported by the running Node.js version are disabled with a warning, so
+// that fuzzing can proceed in the default mode.
+ExecutionOptions ParseExecutionOptions(Napi::Env env,
+                                       const Napi::Object &jsOptions) {
+  ExecutionOptions options;
+  auto zero_copy_input = jsOptions.Get("zeroCopyInput");
+  if (!zero_copy_input.IsBoolean()) {
+    throw Napi::Error::New(env, "zeroCopyInput has to be a boolean");
+  }
+  options.zero_copy_input = zero_copy_input.ToBoolean();
+
+  if (options.zero_copy_input && !IsZeroCopyInputSupported(env)) {
+    std::cerr << "WARN: Zero-copy input is not supported by this Node.js "
+                 "version, falling back to copying the input."
+              << std::endl;
+    options.zero_copy_input = false;
+  }
+
+  auto inline_async = jsOptions.Get("inlineAsync");
+  if (!inline_async.IsBoolean()) {
+    throw Napi::Error::New(env, "inlineAsync has to be a boolean");
+  }
+  options.inline_async = inline_async.ToBoolean();
+
+  auto profile = jsOptions.Get("profile");
+  if (!profile.IsBoolean()) {
+    throw Napi::Error::New(env, "profile has to be a boolean");
+  }
+  options.profile = profile.ToBoolean();
+
+  auto slow_input_directory = jsOptions.Get("slowInputDirectory");
+  if (!slow_input_directory.IsString()) {
+    throw Napi::Error::New(env, "slowInputDirectory has to be a string");
+  }
+  options.slow_input_directory =
+      slow_input_directory.As<Napi::String>().Utf8Value();
+
+  auto gc_budget = jsOptions.Get("gcBudget");
+  if (!gc_budget.IsNumber() ||
+      gc_budget.As<Napi::Number>().DoubleValue() < 0) {
+    throw Napi::Error::New(env, "gcBudget has to be a non-negative number");
+  }
+  // The budget is given in megabytes.
+  options.gc_budget = static_cast<size_t>(
+      gc_budget.As<Napi::Number>().DoubleValue() * 1024 * 1024);
+  return options;
+}
+
 // The following two small functions serve as a simple mechanism for keeping
 // track of encountered return values in the fuzzed target function. IFF both
 // `exclAsyncReturns` and `exclSyncReturns` are toggled the `mixedReturns` is
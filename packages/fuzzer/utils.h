@@ -14,15 +14,36 @@
 
 #pragma once
 
+#include <string>
+
 #include <napi.h>
 // Definitions from compiler-rt, including libfuzzer's entrypoint and the
 // sanitizer runtime initialization function.
 #include <fuzzer/FuzzerDefs.h>
 
+// Options controlling how the JS fuzz target is executed, see
+// `ExecutionOptions` in addon.ts.
+struct ExecutionOptions {
+  // Pass libFuzzer's input to the fuzz target without copying it.
+  bool zero_copy_input = false;
+  // Run async iterations back to back on the JS thread while they don't need
+  // the event loop.
+  bool inline_async = false;
+  // Record the duration of the phases of each iteration, see profiling.h.
+  bool profile = false;
+  // Directory to write unusually slow inputs to while profiling, if not empty.
+  std::string slow_input_directory;
+  // Heap growth in bytes after which a full garbage collection is run between
+  // iterations, see gc_scheduler.h. Disabled if 0.
+  size_t gc_budget = 0;
+};
+
 void StartLibFuzzer(const std::vector<std::string> &args,
                     fuzzer::UserCallback fuzzCallback);
 std::vector<std::string> LibFuzzerArgs(Napi::Env env,
                                        const Napi::Array &jsArgs);
+ExecutionOptions ParseExecutionOptions(Napi::Env env,
+                                       const Napi::Object &jsOptions);
 void AsyncReturnsHandler();
 void SyncReturnsHandler();
 void PrintReturnValueInfo(bool);
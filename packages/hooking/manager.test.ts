@@ -15,7 +15,13 @@
  */
 
 import { HookType } from "./hook";
-import { getFunction, hookManager, setFunction } from "./manager";
+import {
+	callSiteId,
+	getFunction,
+	hookManager,
+	setFunction,
+	useNativeCallSiteIds,
+} from "./manager";
 
 describe("Hooks manager", () => {
 	describe("Matching hooks", () => {
@@ -104,6 +110,20 @@ describe("Hooks manager", () => {
 		});
 	});
 
+	describe("Files to hook", () => {
+		it("should notice hooks registered after a file was checked", () => {
+			hookManager.clearHooks();
+			registerHook(HookType.Before, "foo", "pkg", false);
+			expect(hookManager.hasFunctionsToHook("path/lib/pkg/index.js")).toBe(
+				true,
+			);
+			expect(hookManager.hasFunctionsToHook("path/lib/other.js")).toBe(false);
+			registerHook(HookType.Before, "bar", "other", false);
+			expect(hookManager.hasFunctionsToHook("path/lib/other.js")).toBe(true);
+			expect(hookManager.hookIndex(hookManager.hooks[1])).toBe(1);
+		});
+	});
+
 	describe("getFunction", () => {
 		it("non-existing function", () => {
 			expect(getFunction({}, ["foo", "bar", "lambda"])).toBeUndefined();
@@ -146,6 +166,24 @@ describe("Hooks manager", () => {
 			expect(getFunction(obj, accessorChain)).toStrictEqual(newFunction);
 		});
 	});
+
+	describe("callSiteId", () => {
+		it("should distinguish call sites", () => {
+			const ids = [1, 2].map(() => callSiteId());
+			expect(ids[0]).toEqual(ids[1]);
+			expect(callSiteId()).not.toEqual(ids[0]);
+			expect(callSiteId("foo")).not.toEqual(callSiteId("bar"));
+		});
+
+		it("should pass additional arguments to the native addon as seed", () => {
+			const nativeCallSiteId = jest.fn((seed?: number) => seed ?? 0);
+			useNativeCallSiteIds(nativeCallSiteId);
+			expect(callSiteId()).toEqual(0);
+			expect(callSiteId("foo", 1)).toEqual(callSiteId("foo", 1));
+			expect(callSiteId("foo", 1)).not.toEqual(callSiteId("foo", 2));
+			expect(nativeCallSiteId).toHaveBeenCalledTimes(5);
+		});
+	});
 });
 
 function registerHook(
@@ -115,6 +115,13 @@ export class MatchingHooksResult {
 
 export class HookManager {
 	private _hooks: Hook[] = [];
+	// Indices of the hooks, so that matching functions and files doesn't
+	// have to scan all hooks, which is done for every function of every
+	// instrumented file.
+	private _ids = new Map<Hook, number>();
+	private _hooksByTarget = new Map<string, Hook[]>();
+	private _hooksByPkg = new Map<string, Hook[]>();
+	private _filesToHook = new Map<string, boolean>();
 
 	/**
 	 * Finalizes the registration of new hooks and performs necessary
@@ -172,7 +179,11 @@ export class HookManager {
 		hookFn: HookFn,
 	): Hook {
 		const hook = new Hook(hookType, target, pkg, async, hookFn);
+		this._ids.set(hook, this._hooks.length);
 		this._hooks.push(hook);
+		addToIndex(this._hooksByTarget, target, hook);
+		addToIndex(this._hooksByPkg, pkg, hook);
+		this._filesToHook.clear();
 		return hook;
 	}
 
@@ -182,14 +193,18 @@ export class HookManager {
 
 	clearHooks() {
 		this._hooks = [];
+		this._ids.clear();
+		this._hooksByTarget.clear();
+		this._hooksByPkg.clear();
+		this._filesToHook.clear();
 	}
 
 	hookIndex(hook: Hook): number {
-		return this._hooks.indexOf(hook);
+		return this._ids.get(hook) ?? -1;
 	}
 
 	matchingHooks(target: string, filepath: string): MatchingHooksResult {
-		const matches = this._hooks
+		const matches = (this._hooksByTarget.get(target) ?? [])
 			.filter((hook: Hook) => hook.match(filepath, target))
 			.reduce(
 				(matches: MatchingHooksResult, hook: Hook) => {
@@ -205,39 +220,95 @@ export class HookManager {
 	}
 
 	hasFunctionsToHook(filepath: string): boolean {
-		return (
-			this._hooks.find((hook) => filepath.includes(hook.pkg)) !== undefined
-		);
+		// Checked several times per file, with the same result until new hooks
+		// are registered.
+		let result = this._filesToHook.get(filepath);
+		if (result === undefined) {
+			result = false;
+			for (const pkg of this._hooksByPkg.keys()) {
+				if (filepath.includes(pkg)) {
+					result = true;
+					break;
+				}
+			}
+			this._filesToHook.set(filepath, result);
+		}
+		return result;
 	}
 
+	/**
+	 * Call a hook of any type.  Instrumented code calls the hook type
+	 * specific functions below instead, which don't have to dispatch on the
+	 * type at runtime.
+	 */
 	callHook(
 		id: number,
 		thisPtr: object,
 		params: unknown[],
 		resultOrOriginalFunction: unknown,
 	): unknown {
-		const hook = this._hooks[id];
-		switch (hook.type) {
+		switch (this._hooks[id].type) {
 			case HookType.Before:
-				(hook.hookFunction as BeforeHookFn)(thisPtr, params, callSiteId());
+				this.callBeforeHook(id, thisPtr, params);
 				break;
 			case HookType.Replace:
-				return (hook.hookFunction as ReplaceHookFn)(
+				return this.callReplaceHook(
+					id,
 					thisPtr,
 					params,
-					callSiteId(),
 					// eslint-disable-next-line @typescript-eslint/no-unsafe-function-type
 					resultOrOriginalFunction as Function,
 				);
 			case HookType.After:
-				(hook.hookFunction as AfterHookFn)(
-					thisPtr,
-					params,
-					callSiteId(),
-					resultOrOriginalFunction,
-				);
+				this.callAfterHook(id, thisPtr, params, resultOrOriginalFunction);
 		}
 	}
+
+	callBeforeHook(id: number, thisPtr: object, params: unknown[]): void {
+		(this._hooks[id].hookFunction as BeforeHookFn)(
+			thisPtr,
+			params,
+			callSiteId(),
+		);
+	}
+
+	callReplaceHook(
+		id: number,
+		thisPtr: object,
+		params: unknown[],
+		// eslint-disable-next-line @typescript-eslint/no-unsafe-function-type
+		originalFunction: Function,
+	): unknown {
+		return (this._hooks[id].hookFunction as ReplaceHookFn)(
+			thisPtr,
+			params,
+			callSiteId(),
+			originalFunction,
+		);
+	}
+
+	callAfterHook(
+		id: number,
+		thisPtr: object,
+		params: unknown[],
+		result: unknown,
+	): void {
+		(this._hooks[id].hookFunction as AfterHookFn)(
+			thisPtr,
+			params,
+			callSiteId(),
+			result,
+		);
+	}
+}
+
+function addToIndex(index: Map<string, Hook[]>, key: string, hook: Hook) {
+	const hooks = index.get(key);
+	if (hooks) {
+		hooks.push(hook);
+	} else {
+		index.set(key, [hook]);
+	}
 }
 
 export const hookManager = new HookManager();
@@ -399,20 +470,37 @@ function hookFunction(
 	hookTracker.addApplied(hook.pkg, hook.target);
 }
 
+let nativeCallSiteId: ((seed?: number) => number) | undefined;
+
+/**
+ * Derive call site IDs from the frames of the current stack trace in the
+ * native addon, instead of hashing the formatted stack trace.  The hooking
+ * package is also used in the ESM loader thread and thus doesn't depend on
+ * the addon itself.
+ */
+export function useNativeCallSiteIds(fn: (seed?: number) => number) {
+	nativeCallSiteId = fn;
+}
+
 /**
  * Returns a unique id for the call site of the function that called this function.
  * @param additionalArguments additional arguments to be included in the hash
  */
 export function callSiteId(...additionalArguments: unknown[]): number {
-	const stackTrace = additionalArguments?.join(",") + new Error().stack;
-	if (!stackTrace || stackTrace.length === 0) {
-		return 0;
+	if (nativeCallSiteId) {
+		return additionalArguments.length === 0
+			? nativeCallSiteId()
+			: nativeCallSiteId(hashString(additionalArguments.join(",")));
 	}
+	return hashString(additionalArguments?.join(",") + new Error().stack);
+}
+
+function hashString(value: string): number {
 	let hash = 0,
 		i,
 		chr;
-	for (i = 0; i < stackTrace.length; i++) {
-		chr = stackTrace.charCodeAt(i);
+	for (i = 0; i < value.length; i++) {
+		chr = value.charCodeAt(i);
 		hash = (hash << 5) - hash + chr;
 		hash |= 0; // Convert to 32bit integer
 	}
@@ -41,7 +41,12 @@ if (process.listeners) {
 export interface EdgeIdStrategy {
 	nextEdgeId(): number;
 	startForSourceFile(filename: string): void;
-	commitIdCount(filename: string): void;
+	/**
+	 * Finish the edge IDs of a source file.  Strategies that hand out
+	 * provisional IDs while the file is instrumented return the actual first
+	 * ID of the file here, which the counters are relocated to.
+	 */
+	commitIdCount(filename: string): number | void;
 }
 
 export abstract class IncrementingEdgeIdStrategy implements EdgeIdStrategy {
@@ -53,7 +58,7 @@ export abstract class IncrementingEdgeIdStrategy implements EdgeIdStrategy {
 	}
 
 	abstract startForSourceFile(filename: string): void;
-	abstract commitIdCount(filename: string): void;
+	abstract commitIdCount(filename: string): number | void;
 }
 
 export class MemorySyncIdStrategy extends IncrementingEdgeIdStrategy {
@@ -81,20 +86,50 @@ interface EdgeIdInfo {
  * with other processes via the specified `idSyncFile`. The edge information stored as a
  * line of the format: <source file path>,<initial edge ID>,<total edge count>
  *
- * This class takes care of synchronizing the access to the file between
- * multiple processes accessing it during instrumentation.
+ * The IDs are looked up and allocated in the edge ID table of the native addon,
+ * a memory-mapped file next to the ID sync file, which only makes processes
+ * instrumenting the same source file wait for each other.  The table persists,
+ * so later runs with the same ID sync file assign the same IDs.  The ID sync file
+ * is still written as an export of the table.
+ *
+ * If the table can't be opened, this class takes care of synchronizing the access to
+ * the file between multiple processes accessing it during instrumentation.
  */
 export class FileSyncIdStrategy extends IncrementingEdgeIdStrategy {
 	private static readonly fatalExitCode = 79;
 	private cachedIdCount: number | undefined;
 	private firstEdgeId: number | undefined;
 	private releaseLockOnSyncFile: (() => void) | undefined;
+	private readonly table: number | undefined;
+	private claimed = false;
+	private shared = true;
 
 	constructor(private idSyncFile: string) {
 		super(0);
+		this.table = fuzzer.openEdgeIdTable(`${idSyncFile}.table`);
 	}
 
 	startForSourceFile(filename: string): void {
+		if (this.table !== undefined) {
+			const ids = fuzzer.claimEdgeIds(this.table, filename);
+			// Files claimed by this thread get their IDs when they are committed,
+			// until then, the IDs are counted from 0. The same goes for files whose
+			// claim by another thread wasn't committed in time, but their IDs are
+			// only valid in this process.
+			this.shared = ids !== undefined;
+			if (!this.shared) {
+				console.error(
+					`WARN: Timed out waiting for the edge IDs of ${filename}, ` +
+						"they are not shared with other processes",
+				);
+			}
+			this.claimed = !ids;
+			this.firstEdgeId = ids?.[0] ?? 0;
+			this.cachedIdCount = ids?.[1];
+			this._nextEdgeId = this.firstEdgeId;
+			return;
+		}
+
 		// We resort to busy waiting since the `Transformer` required by istanbul's `hookRequire`
 		// must be a synchronous function returning the transformed code.
 		for (;;) {
@@ -182,12 +217,34 @@ export class FileSyncIdStrategy extends IncrementingEdgeIdStrategy {
 
 		this._nextEdgeId = this.firstEdgeId;
 	}
-	commitIdCount(filename: string): void {
+	commitIdCount(filename: string): number | void {
 		if (this.firstEdgeId === undefined) {
 			throw Error("commitIdCount() is called before startForSourceFile()");
 		}
 
 		const usedIdsCount = this._nextEdgeId - this.firstEdgeId;
+		if (this.claimed && this.table !== undefined) {
+			const firstId = fuzzer.commitEdgeIds(
+				this.table,
+				filename,
+				usedIdsCount,
+				this.shared,
+			);
+			if (usedIdsCount > 0) {
+				fuzzer.coverageTracker.enlargeCountersBufferIfNeeded(
+					firstId + usedIdsCount - 1,
+				);
+			}
+			if (this.shared) {
+				fs.appendFileSync(
+					this.idSyncFile,
+					`${filename},${firstId},${usedIdsCount}${os.EOL}`,
+				);
+			}
+			this.claimed = false;
+			this.firstEdgeId = undefined;
+			return firstId;
+		}
 		if (this.cachedIdCount !== undefined) {
 			// We released the lock already in startForSourceFile since the file had already been instrumented
 			// elsewhere. As we know the expected number of IDs for the current source file in this case, check
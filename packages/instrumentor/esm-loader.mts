@@ -50,9 +50,11 @@ const { hookManager: loaderHookManager } =
 	require("@jazzer.js/hooking") as typeof import("@jazzer.js/hooking");
 const { setSeed } =
 	require("./plugins/helpers.js") as typeof import("./plugins/helpers.js");
+const { InstrumentationCache } =
+	require("./instrumentationCache.js") as typeof import("./instrumentationCache.js");
 
 // Already-instrumented code contains this marker.
-const INSTRUMENTATION_MARKER = "Fuzzer.coverageTracker.incrementCounter";
+const INSTRUMENTATION_MARKER = "Fuzzer.coverageTracker.counterRange";
 
 // Counter buffer variable injected into each instrumented module.
 const COUNTER_ARRAY = "__jazzer_cov";
@@ -62,11 +64,17 @@ interface LoaderConfig {
 	excludes: string[];
 	coverage: boolean;
 	seed?: number;
+	pruneCounters?: boolean;
+	symbolizeCounters?: boolean;
+	blockCoverage?: boolean;
+	blockCoverageCompareHooks?: boolean;
+	cacheDirectory?: string;
 	port?: MessagePort;
 }
 
 let config: LoaderConfig;
 let loaderPort: MessagePort | null = null;
+let cache: InstanceType<typeof InstrumentationCache> | null = null;
 
 export function initialize(data: LoaderConfig): void {
 	config = data;
@@ -76,6 +84,9 @@ export function initialize(data: LoaderConfig): void {
 	if (data.port) {
 		loaderPort = data.port;
 	}
+	if (data.cacheDirectory) {
+		cache = new InstrumentationCache(data.cacheDirectory);
+	}
 }
 
 interface LoadResult {
@@ -141,9 +152,39 @@ export const load: LoadFn = async function load(url, context, nextLoad) {
 function instrumentModule(code: string, filename: string): string | null {
 	drainHookUpdates();
 
-	const fuzzerCoverage = esmCodeCoverage();
+	// ES modules have their own counters, so cached modules can be used as
+	// they are.
+	const cacheKey = cache?.key(filename, code, {
+		esm: true,
+		pruneCounters: config.pruneCounters,
+		symbolizeCounters: config.symbolizeCounters,
+		blockCoverage: config.blockCoverage,
+		blockCoverageCompareHooks: config.blockCoverageCompareHooks,
+		coverage: config.coverage,
+		seed: config.seed,
+		hooks: loaderHookManager.hasFunctionsToHook(filename)
+			? loaderHookManager.hooks.map((hook) => [
+					hook.type,
+					hook.target,
+					hook.pkg,
+					hook.async,
+				])
+			: [],
+	});
+	const cached = cacheKey ? cache?.load(cacheKey) : undefined;
+	if (cached) {
+		return cached.code;
+	}
+
+	const fuzzerCoverage = esmCodeCoverage(config.pruneCounters);
 
-	const plugins: PluginItem[] = [fuzzerCoverage.plugin, compareHooks];
+	// With block coverage, the coverage feedback comes from V8 and only
+	// the compare hooks are needed, if they are requested at all.
+	const plugins: PluginItem[] = config.blockCoverage
+		? config.blockCoverageCompareHooks
+			? [compareHooks]
+			: []
+		: [fuzzerCoverage.plugin, compareHooks];
 
 	// When --coverage is active, also apply Istanbul instrumentation so
 	// that ESM modules appear in the human-readable coverage report.
@@ -155,12 +196,16 @@ function instrumentModule(code: string, filename: string): string | null {
 
 	// Apply function hooks if the main thread has sent hook definitions
 	// and any of them target functions in this file.  The instrumented
-	// code calls HookManager.callHook(id, ...) at runtime, which
+	// code calls the HookManager with the hook ID at runtime, which
 	// resolves to the real hook function on the main thread.
 	if (loaderHookManager.hasFunctionsToHook(filename)) {
 		plugins.push(functionHooks(filename));
 	}
 
+	if (plugins.length === 0) {
+		return null;
+	}
+
 	let transformed: ReturnType<typeof transformSync>;
 	try {
 		transformed = transformSync(code, {
@@ -177,7 +222,7 @@ function instrumentModule(code: string, filename: string): string | null {
 	}
 
 	const edges = fuzzerCoverage.edgeCount();
-	if (edges === 0 || !transformed?.code) {
+	if ((edges === 0 && !config.blockCoverage) || !transformed?.code) {
 		return null;
 	}
 
@@ -185,10 +230,17 @@ function instrumentModule(code: string, filename: string): string | null {
 	// body.  It allocates the per-module coverage counter buffer and,
 	// when a source map is available, registers it with the main-thread
 	// SourceMapRegistry so that source-map-support can remap stack
-	// traces back to the original source.
-	const preambleLines = [
-		`const ${COUNTER_ARRAY} = Fuzzer.coverageTracker.createModuleCounters(${edges});`,
-	];
+	// traces back to the original source.  If libFuzzer output is
+	// symbolized, the source locations of the counters are passed along.
+	const preambleLines: string[] = [];
+	if (edges > 0) {
+		const symbols = config.symbolizeCounters
+			? `, ${JSON.stringify(fuzzerCoverage.symbols(filename))}`
+			: "";
+		preambleLines.push(
+			`const ${COUNTER_ARRAY} = Fuzzer.coverageTracker.createModuleCounters(${edges}${symbols});`,
+		);
+	}
 
 	if (transformed.map) {
 		// Shift the source map to account for the preamble lines we are
@@ -205,7 +257,11 @@ function instrumentModule(code: string, filename: string): string | null {
 		);
 	}
 
-	return preambleLines.join("\n") + "\n" + transformed.code;
+	const instrumented = preambleLines.join("\n") + "\n" + transformed.code;
+	if (cacheKey) {
+		cache?.store(cacheKey, { code: instrumented });
+	}
+	return instrumented;
 }
 
 // ── Function hooks from the main thread ──────────────────────────
@@ -244,7 +300,7 @@ function drainHookUpdates(): void {
 				noop,
 			);
 			// Sanity check: the stub's index in the loader must match the
-			// main thread's index so that runtime HookManager.callHook(id)
+			// main thread's index so that the hook calls at runtime
 			// invokes the correct hook function.
 			const actualId = loaderHookManager.hookIndex(stub);
 			if (actualId !== h.id) {
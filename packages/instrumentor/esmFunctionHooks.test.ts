@@ -152,7 +152,7 @@ describe("ESM function hook stub registration", () => {
 });
 
 describe("ESM function hook Babel output", () => {
-	it("should insert HookManager.callHook with the correct hook ID", () => {
+	it("should insert HookManager.callBeforeHook with the correct hook ID", () => {
 		hookManager.registerHook(
 			HookType.Before,
 			"processInput",
@@ -169,7 +169,7 @@ describe("ESM function hook Babel output", () => {
 			},
 		);
 
-		expect(result?.code).toContain("HookManager.callHook(0,");
+		expect(result?.code).toContain("HookManager.callBeforeHook(0,");
 		expect(result?.code).toContain("this, [data]");
 	});
 
@@ -187,7 +187,7 @@ describe("ESM function hook Babel output", () => {
 			plugins: [functionHooks("/app/node_modules/other-pkg/lib.js")],
 		});
 
-		expect(result?.code).not.toContain("HookManager.callHook");
+		expect(result?.code).not.toContain("HookManager.call");
 	});
 
 	it("should use sendHooksToLoader to serialize from Instrumentor", () => {
@@ -14,10 +14,16 @@
  * limitations under the License.
  */
 
+import * as fs from "fs";
+
+import * as tmp from "tmp";
 import ts from "typescript";
 
+import { MemorySyncIdStrategy } from "./edgeIdStrategy";
 import { Instrumentor } from "./instrument";
 
+tmp.setGracefulCleanup();
+
 describe("shouldInstrument check", () => {
 	it("should consider includes and excludes", () => {
 		const instrumentor = new Instrumentor(["include"], ["exclude"]);
@@ -146,6 +152,106 @@ describe("transform", () => {
 	});
 });
 
+describe("instrumentation cache", () => {
+	it("should rebase the edge IDs of cached modules", () => {
+		const cacheDirectory = tmp.dirSync({ unsafeCleanup: true }).name;
+		const withCache = () =>
+			new Instrumentor(
+				[],
+				[],
+				[],
+				false,
+				false,
+				new MemorySyncIdStrategy(),
+				undefined,
+				undefined,
+				false,
+				false,
+				false,
+				cacheDirectory,
+			);
+		const code = "if (a) { b(); }";
+
+		const first = withCache().instrument(code, "cached.js")?.code;
+		expect(first).toContain("counterRange(0, 2)");
+		expect(fs.readdirSync(cacheDirectory)).toHaveLength(1);
+
+		// Another module takes the edge IDs of the first run.
+		const instrumentor = withCache();
+		instrumentor.instrument("if (c) { d(); }", "other.js");
+		const cached = instrumentor.instrument(code, "cached.js")?.code;
+		expect(cached).toBe(
+			first?.replace("counterRange(0, 2)", "counterRange(2, 2)"),
+		);
+	});
+
+	it("should not share modules between included and excluded files", () => {
+		const cacheDirectory = tmp.dirSync({ unsafeCleanup: true }).name;
+		// Source code coverage is also collected for excluded files matching
+		// the custom hooks.
+		const withCache = (excludes: string[]) =>
+			new Instrumentor(
+				["*"],
+				excludes,
+				["cached.js"],
+				true,
+				false,
+				new MemorySyncIdStrategy(),
+				undefined,
+				undefined,
+				false,
+				false,
+				false,
+				cacheDirectory,
+			);
+		const code = "if (a) { b(); }";
+
+		const included = withCache([]).instrument(code, "cached.js")?.code;
+		expect(included).toContain("counterRange(0, 2)");
+		const excluded = withCache(["cached"]).instrument(code, "cached.js")?.code;
+		expect(excluded).toBeDefined();
+		expect(excluded).not.toContain("counterRange");
+		expect(fs.readdirSync(cacheDirectory)).toHaveLength(2);
+
+		const includedAgain = withCache([]).instrument(code, "cached.js")?.code;
+		expect(includedAgain).toBe(included);
+	});
+});
+
+describe("block coverage", () => {
+	const withBlockCoverage = (compareHooks: boolean) =>
+		new Instrumentor(
+			[],
+			[],
+			[],
+			false,
+			false,
+			new MemorySyncIdStrategy(),
+			undefined,
+			undefined,
+			false,
+			true,
+			false,
+			"",
+			false,
+			compareHooks,
+		);
+	const code = 'if (a === "b") { c(); }';
+
+	it("should not transform modules without compare hooks", () => {
+		expect(withBlockCoverage(false).instrument(code, "module.js")).toBeNull();
+	});
+
+	it("should only rewrite comparisons with compare hooks", () => {
+		const instrumented = withBlockCoverage(true).instrument(
+			code,
+			"module.js",
+		)?.code;
+		expect(instrumented).toContain("Fuzzer.tracer.traceStrCmp");
+		expect(instrumented).not.toContain("counterRange");
+	});
+});
+
 function evalWithInstrumentor(
 	instrumentor: Instrumentor,
 	content: string,
@@ -166,9 +272,8 @@ function withSourceMap(fn: (instrumentor: Instrumentor) => void) {
 	globalThis.Fuzzer = {
 		// @ts-ignore
 		coverageTracker: {
-			incrementCounter: () => {
-				// ignored
-			},
+			counterRange: (firstEdgeId: number, edgeCount: number) =>
+				new Uint8Array(edgeCount),
 		},
 	};
 	const instrumentor = new Instrumentor([], [], [], true, false);
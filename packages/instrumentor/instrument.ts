@@ -29,11 +29,17 @@ import { hookRequire, TransformerOptions } from "istanbul-lib-hook";
 import { hookManager, HookType } from "@jazzer.js/hooking";
 
 import { EdgeIdStrategy, MemorySyncIdStrategy } from "./edgeIdStrategy";
+import { InstrumentationCache } from "./instrumentationCache";
 import { instrumentationPlugins } from "./plugin";
 import { codeCoverage } from "./plugins/codeCoverage";
 import { compareHooks } from "./plugins/compareHooks";
 import { functionHooks } from "./plugins/functionHooks";
 import { setSeed } from "./plugins/helpers";
+import {
+	LazyFunction,
+	lazyFunctions,
+	lazyFunctionsPlugin,
+} from "./plugins/lazyFunctions";
 import { sourceCodeCoverage } from "./plugins/sourceCodeCoverage";
 import {
 	extractInlineSourceMap,
@@ -50,6 +56,10 @@ export {
 	MemorySyncIdStrategy,
 } from "./edgeIdStrategy";
 export { SourceMap } from "./SourceMapRegistry";
+export {
+	LazyFunctionRegistry,
+	lazyFunctions,
+} from "./plugins/lazyFunctions";
 
 /**
  * Serializable hook descriptor sent from the main thread to the ESM
@@ -64,8 +74,20 @@ export interface SerializedHook {
 	async: boolean;
 }
 
+// Header of modules with coverage counters, see codeCoverage.
+const COUNTER_RANGE = /Fuzzer\.coverageTracker\.counterRange\((\d+), (\d+)/;
+
+// Move the counters of a module to the given first edge ID.
+function rebaseCounters(code: string, firstId: number): string {
+	return code.replace(
+		COUNTER_RANGE,
+		(header, id) => header.replace(`(${id},`, `(${firstId},`),
+	);
+}
+
 export class Instrumentor {
 	private loaderPort: MessagePort | null = null;
+	private readonly cache: InstrumentationCache | undefined;
 
 	constructor(
 		private readonly includes: string[] = [],
@@ -76,6 +98,12 @@ export class Instrumentor {
 		private readonly idStrategy: EdgeIdStrategy = new MemorySyncIdStrategy(),
 		private readonly sourceMapRegistry: SourceMapRegistry = new SourceMapRegistry(),
 		private readonly _seed: number = 0xdead_beef,
+		private readonly pruneCounters = false,
+		private readonly blockCoverage = false,
+		private readonly lazyInstrumentation = false,
+		private readonly cacheDirectory = "",
+		private readonly symbolizeCounters = false,
+		private readonly blockCoverageCompareHooks = false,
 	) {
 		// This is our default case where we want to include everything and exclude the "node_modules" folder.
 		if (includes.length === 0 && excludes.length === 0) {
@@ -84,6 +112,9 @@ export class Instrumentor {
 		}
 		this.includes = Instrumentor.cleanup(includes);
 		this.excludes = Instrumentor.cleanup(excludes);
+		if (cacheDirectory) {
+			this.cache = new InstrumentationCache(cacheDirectory);
+		}
 	}
 
 	init(): () => void {
@@ -105,6 +136,10 @@ export class Instrumentor {
 			map: SourceMap,
 		) => registry.registerSourceMap(filename, map);
 
+		if (this.lazyInstrumentation) {
+			lazyFunctions.setCompiler((fn) => this.instrumentLazyFunction(fn));
+		}
+
 		return this.sourceMapRegistry.installSourceMapSupport();
 	}
 
@@ -115,12 +150,20 @@ export class Instrumentor {
 		const transformations: PluginItem[] = [];
 
 		const shouldInstrumentFile = this.shouldInstrumentForFuzzing(filename);
+		// Functions are replaced before any other plugin sees them. Hooked
+		// functions and source code coverage need the whole module.
+		const lazy =
+			shouldInstrumentFile &&
+			this.lazyInstrumentation &&
+			!hookManager.hasFunctionsToHook(filename) &&
+			!this.shouldCollectCodeCoverage(filename);
 		if (shouldInstrumentFile) {
-			transformations.push(
-				...instrumentationPlugins.plugins,
-				codeCoverage(this.idStrategy),
-				compareHooks,
-			);
+			if (lazy) {
+				transformations.push(
+					lazyFunctionsPlugin(lazyFunctions, filename, inputSourceMap),
+				);
+			}
+			transformations.push(...this.fuzzingPlugins());
 		}
 
 		if (hookManager.hasFunctionsToHook(filename)) {
@@ -136,6 +179,27 @@ export class Instrumentor {
 			);
 		}
 
+		if (transformations.length === 0) {
+			return null;
+		}
+
+		// Stubs of lazily instrumented functions only exist in this process.
+		const cacheKey =
+			this.cache && !lazy
+				? this.cache.key(
+						filename,
+						code,
+						inputSourceMap ?? null,
+						this.cacheInputs(filename, shouldInstrumentFile),
+					)
+				: undefined;
+		if (cacheKey) {
+			const cached = this.loadCached(cacheKey, filename, shouldInstrumentFile);
+			if (cached) {
+				return cached;
+			}
+		}
+
 		if (shouldInstrumentFile) {
 			this.idStrategy.startForSourceFile(filename);
 		}
@@ -158,11 +222,128 @@ export class Instrumentor {
 			}
 		}
 		if (shouldInstrumentFile) {
-			this.idStrategy.commitIdCount(filename);
+			const firstId = this.idStrategy.commitIdCount(filename);
+			if (firstId !== undefined && result?.code) {
+				result.code = rebaseCounters(result.code, firstId);
+			}
+		}
+		if (cacheKey && result?.code) {
+			this.cache?.store(cacheKey, {
+				code: result.code,
+				map: result.map as SourceMap | null | undefined,
+			});
 		}
 		return result;
 	}
 
+	// Everything besides the module itself that affects its instrumentation.
+	private cacheInputs(filename: string, shouldInstrumentFile: boolean) {
+		return {
+			// The plugins alone don't tell fuzzing instrumentation apart, as none
+			// may be registered.
+			fuzz: shouldInstrumentFile,
+			plugins: shouldInstrumentFile ? instrumentationPlugins.cacheKeys : [],
+			blockCoverage: this.blockCoverage,
+			blockCoverageCompareHooks: this.blockCoverageCompareHooks,
+			pruneCounters: this.pruneCounters,
+			symbolizeCounters: this.symbolizeCounters,
+			seed: this._seed,
+			coverage: this.shouldCollectCodeCoverage(filename),
+			hooks: hookManager.hasFunctionsToHook(filename)
+				? hookManager.hooks.map((hook) => [
+						hook.type,
+						hook.target,
+						hook.pkg,
+						hook.async,
+					])
+				: [],
+		};
+	}
+
+	/**
+	 * Load an instrumented module from the cache.  The counters of the module
+	 * are rebased on the edge IDs the module gets in this process, which
+	 * differ between runs and, without an ID sync file, between processes.
+	 */
+	private loadCached(
+		key: string,
+		filename: string,
+		shouldInstrumentFile: boolean,
+	): BabelFileResult | null {
+		const entry = this.cache?.load(key);
+		if (!entry) {
+			return null;
+		}
+		let code = entry.code;
+		if (shouldInstrumentFile) {
+			this.idStrategy.startForSourceFile(filename);
+			const count = parseInt(COUNTER_RANGE.exec(code)?.[2] ?? "0", 10);
+			const ids = Array.from({ length: count }, () =>
+				this.idStrategy.nextEdgeId(),
+			);
+			const firstId = this.idStrategy.commitIdCount(filename) ?? ids[0];
+			code = rebaseCounters(code, firstId ?? 0);
+		}
+		if (entry.map) {
+			this.sourceMapRegistry.registerSourceMap(filename, entry.map);
+		}
+		return { code, map: entry.map } as BabelFileResult;
+	}
+
+	private fuzzingPlugins(): PluginItem[] {
+		const plugins: PluginItem[] = [...instrumentationPlugins.plugins];
+		// With block coverage, the coverage feedback comes from V8. Unless the
+		// compare hooks are requested as well, modules without other plugins
+		// aren't transformed at all, which is what makes it start fast.
+		if (!this.blockCoverage) {
+			plugins.push(
+				codeCoverage(
+					this.idStrategy,
+					this.pruneCounters,
+					this.symbolizeCounters,
+				),
+			);
+		}
+		if (!this.blockCoverage || this.blockCoverageCompareHooks) {
+			plugins.push(compareHooks);
+		}
+		return plugins;
+	}
+
+	/**
+	 * Instrument a function replaced by a stub in lazy mode, on its first
+	 * call.  The function gets its own edge IDs and source map, registered
+	 * under the source URL of the returned code.
+	 */
+	private instrumentLazyFunction(fn: LazyFunction): string {
+		const name = `${fn.filename}?lazy=${fn.line}:${fn.column}`;
+		// Keep the line numbers of the module in coverage symbols and stack
+		// traces.
+		const code = "\n".repeat(fn.line - 1) + fn.source;
+		this.idStrategy.startForSourceFile(name);
+		let result: BabelFileResult | null = null;
+		try {
+			result = this.transform(name, code, this.fuzzingPlugins(), {
+				sourceFileName: fn.filename,
+				retainLines: true,
+				...this.asInputSourceOption(fn.inputSourceMap),
+			});
+		} catch (e) {
+			if (process.env.JAZZER_DEBUG) {
+				const message = e instanceof Error ? e.message : e;
+				console.error(
+					`Instrumentation error in function ${name}:\n  ${message}`,
+				);
+			}
+		}
+		const firstId = this.idStrategy.commitIdCount(name);
+		let instrumented = result?.code ?? code;
+		if (firstId !== undefined) {
+			instrumented = rebaseCounters(instrumented, firstId);
+		}
+		return `${instrumented}\n//# sourceURL=${name}`;
+	}
+
 	// eslint-disable-next-line @typescript-eslint/no-explicit-any
 	private asInputSourceOption(inputSourceMap: any): any {
 		// Empty input source maps mess up the coverage report.
@@ -239,6 +420,30 @@ export class Instrumentor {
 		return this._seed;
 	}
 
+	get counterPruningEnabled(): boolean {
+		return this.pruneCounters;
+	}
+
+	get counterSymbolizationEnabled(): boolean {
+		return this.symbolizeCounters;
+	}
+
+	get blockCoverageEnabled(): boolean {
+		return this.blockCoverage;
+	}
+
+	get blockCoverageCompareHooksEnabled(): boolean {
+		return this.blockCoverageCompareHooks;
+	}
+
+	get lazyInstrumentationEnabled(): boolean {
+		return this.lazyInstrumentation;
+	}
+
+	get instrumentationCacheDirectory(): string {
+		return this.cacheDirectory;
+	}
+
 	/** Connect the main-thread side of the loader MessagePort. */
 	setLoaderPort(port: MessagePort): void {
 		this.loaderPort = port;
@@ -377,6 +582,11 @@ function registerEsmHooks(instrumentor: Instrumentor): void {
 			excludes: instrumentor.excludePatterns,
 			coverage: instrumentor.coverageEnabled,
 			seed: instrumentor.seed,
+			pruneCounters: instrumentor.counterPruningEnabled,
+			symbolizeCounters: instrumentor.counterSymbolizationEnabled,
+			blockCoverage: instrumentor.blockCoverageEnabled,
+			blockCoverageCompareHooks: instrumentor.blockCoverageCompareHooksEnabled,
+			cacheDirectory: instrumentor.instrumentationCacheDirectory,
 		};
 
 		const options: {
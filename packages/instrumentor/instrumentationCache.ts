@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * On-disk cache of instrumented modules, shared by all processes of a
+ * fuzzing campaign and reused across runs.
+ *
+ * Entries are addressed by a hash of everything the instrumentation depends
+ * on: the source code and file name, the instrumentor version, the plugins,
+ * the seed and the function hooks.  Each entry is written to a temporary file
+ * first and then renamed, so that concurrent processes only ever see complete
+ * entries.  Processes instrumenting the same module at the same time simply
+ * write identical entries.
+ *
+ * This module is also used by the ESM loader thread and therefore must not
+ * depend on the native fuzzer addon.
+ */
+
+import * as crypto from "crypto";
+import * as fs from "fs";
+import * as path from "path";
+
+import type { SourceMap } from "./SourceMapRegistry";
+
+// Bumped whenever the format of the entries changes.
+const CACHE_FORMAT = 1;
+
+export interface CacheEntry {
+	code: string;
+	map?: SourceMap | null;
+}
+
+export class InstrumentationCache {
+	constructor(private readonly directory: string) {}
+
+	/**
+	 * Key of a module, derived from all inputs of its instrumentation.
+	 */
+	key(...inputs: unknown[]): string {
+		const hash = crypto.createHash("sha256");
+		hash.update(`${CACHE_FORMAT}\0${instrumentorVersion()}`);
+		for (const input of inputs) {
+			hash.update("\0");
+			hash.update(typeof input === "string" ? input : JSON.stringify(input));
+		}
+		return hash.digest("hex");
+	}
+
+	load(key: string): CacheEntry | undefined {
+		try {
+			return JSON.parse(fs.readFileSync(this.entryPath(key), "utf8"));
+		} catch {
+			// Missing or unreadable entries are instrumented again.
+			return undefined;
+		}
+	}
+
+	store(key: string, entry: CacheEntry) {
+		const entryPath = this.entryPath(key);
+		const tmpPath = `${entryPath}.${process.pid}.${Math.random()
+			.toString(36)
+			.slice(2)}`;
+		try {
+			fs.mkdirSync(path.dirname(entryPath), { recursive: true });
+			fs.writeFileSync(tmpPath, JSON.stringify(entry));
+			fs.renameSync(tmpPath, entryPath);
+		} catch (e) {
+			fs.rmSync(tmpPath, { force: true });
+			if (process.env.JAZZER_DEBUG) {
+				const message = e instanceof Error ? e.message : e;
+				console.error(
+					`Could not store instrumentation cache entry:\n  ${message}`,
+				);
+			}
+		}
+	}
+
+	// Entries are spread over subdirectories to keep directories small.
+	private entryPath(key: string): string {
+		return path.join(this.directory, key.slice(0, 2), key.slice(2));
+	}
+}
+
+let version: string | undefined;
+
+function instrumentorVersion(): string {
+	if (version === undefined) {
+		try {
+			version = require("@jazzer.js/instrumentor/package.json").version;
+		} catch {
+			version = "";
+		}
+	}
+	return version ?? "";
+}
@@ -22,18 +22,40 @@ import { PluginTarget } from "@babel/core";
  */
 export class InstrumentationPlugins {
 	private _plugins: Array<() => PluginTarget> = [];
+	private _states: Array<(() => unknown) | undefined> = [];
 
-	registerPlugin(plugin: () => PluginTarget) {
+	registerPlugin(plugin: () => PluginTarget, state?: () => unknown) {
 		this._plugins.push(plugin);
+		this._states.push(state);
 	}
 
 	get plugins() {
 		return this._plugins;
 	}
+
+	/**
+	 * Identifies the registered plugins for the instrumentation cache, by
+	 * their code and the state their output depends on.
+	 */
+	get cacheKeys(): unknown[] {
+		return this._plugins.map((plugin, index) => [
+			String(plugin),
+			this._states[index]?.() ?? null,
+		]);
+	}
 }
 
 export const instrumentationPlugins = new InstrumentationPlugins();
 
-export function registerInstrumentationPlugin(plugin: () => PluginTarget) {
-	instrumentationPlugins.registerPlugin(plugin);
+/**
+ * Register an instrumentation plugin.  If the output of the plugin depends
+ * on any state besides its code, e.g. a configuration, `state` has to return
+ * that state, so that cached instrumentation results are only used for the
+ * same state.
+ */
+export function registerInstrumentationPlugin(
+	plugin: () => PluginTarget,
+	state?: () => unknown,
+) {
+	instrumentationPlugins.registerPlugin(plugin, state);
 }
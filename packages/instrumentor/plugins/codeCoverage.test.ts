@@ -19,16 +19,20 @@ import * as os from "os";
 
 import * as tmp from "tmp";
 
-import { FileSyncIdStrategy, ZeroEdgeIdStrategy } from "../edgeIdStrategy";
+import {
+	FileSyncIdStrategy,
+	MemorySyncIdStrategy,
+	ZeroEdgeIdStrategy,
+} from "../edgeIdStrategy";
 import { Instrumentor } from "../instrument";
 
 import { codeCoverage } from "./codeCoverage";
-import { instrumentWith } from "./testhelpers";
+import { instrumentWith, removeIndentation } from "./testhelpers";
 
 tmp.setGracefulCleanup();
 
 const expectInstrumentation = instrumentWith(
-	codeCoverage(new ZeroEdgeIdStrategy()),
+	codeCoverage(new ZeroEdgeIdStrategy(), false, true),
 );
 
 describe("code coverage instrumentation", () => {
@@ -38,12 +42,13 @@ describe("code coverage instrumentation", () => {
                |if (1 < 2)
                |  true;`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 2, 3, 0, 2, 8], []]);
                |if (1 < 2) {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  true;
                |}
                |
-               |Fuzzer.coverageTracker.incrementCounter(0);`;
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
 		it("should add counter in alternate branch and afterwards", () => {
@@ -53,15 +58,16 @@ describe("code coverage instrumentation", () => {
                |else
                |  false;`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 3, ["test.js", ["<top-level>"], [0, 2, 3, 0, 4, 3, 0, 4, 9], []]);
                |if (1 < 2) {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  true;
                |} else {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  false;
                |}
                |
-               |Fuzzer.coverageTracker.incrementCounter(0);`;
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
 	});
@@ -75,22 +81,23 @@ describe("code coverage instrumentation", () => {
                |  default: true;
                |}`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 4, ["test.js", ["<top-level>"], [0, 2, 3, 0, 3, 3, 0, 4, 3, 0, 5, 2], []]);
                |switch (a) {
                |  case 1:
-               |    Fuzzer.coverageTracker.incrementCounter(0);
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |    true;
                |
                |  case 2:
-               |    Fuzzer.coverageTracker.incrementCounter(0);
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |    false;
                |    break;
                |
                |  default:
-               |    Fuzzer.coverageTracker.incrementCounter(0);
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |    true;
                |}
                |
-               |Fuzzer.coverageTracker.incrementCounter(0);`;
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
 	});
@@ -104,14 +111,15 @@ describe("code coverage instrumentation", () => {
                |  console.error(e, e.stack);
                |}`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 3, 3, 0, 5, 2], []]);
                |try {
                |  dangerousCall();
                |} catch (e) {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  console.error(e, e.stack);
                |}
                |
-               |Fuzzer.coverageTracker.incrementCounter(0);`;
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
 	});
@@ -123,12 +131,13 @@ describe("code coverage instrumentation", () => {
                |  counter++
                |}`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 1, 30, 0, 3, 2], []]);
                |for (let i = 0; i < 100; i++) {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  counter++;
                |}
                |
-               |Fuzzer.coverageTracker.incrementCounter(0);`;
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
 	});
@@ -142,10 +151,11 @@ describe("code coverage instrumentation", () => {
                |  } 
                |};`;
 			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["add", "<anonymous>"], [0, 1, 11, 1, 2, 10], [0, 1]]);
                |let foo = function add(a) {
-               |  Fuzzer.coverageTracker.incrementCounter(0);
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |  return b => {
-               |    Fuzzer.coverageTracker.incrementCounter(0);
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
                |    return a + b;
                |  };
                |};`;
@@ -156,7 +166,9 @@ describe("code coverage instrumentation", () => {
 	describe("LogicalExpression", () => {
 		it("should add counters in leaves", () => {
 			const input = `let condition = (a === "a" || (potentiallyNull ?? b === "b")) && c !== "c"`;
-			const output = `let condition = ((Fuzzer.coverageTracker.incrementCounter(0), a === "a") || ((Fuzzer.coverageTracker.incrementCounter(0), potentiallyNull) ?? (Fuzzer.coverageTracker.incrementCounter(0), b === "b"))) && (Fuzzer.coverageTracker.incrementCounter(0), c !== "c");`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 4, ["test.js", ["<top-level>"], [0, 1, 66, 0, 1, 18, 0, 1, 32, 0, 1, 51], []]);
+               |let condition = ((__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, a === "a") || ((__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, potentiallyNull) ?? (__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, b === "b"))) && (__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, c !== "c");`;
 			expectInstrumentation(input, output);
 		});
 	});
@@ -165,9 +177,154 @@ describe("code coverage instrumentation", () => {
 		it("should add counters branches", () => {
 			const input = `(a === "a" ? x : y) + 1`;
 			const output = `
-        |(a === "a" ? (Fuzzer.coverageTracker.incrementCounter(0), x) : (Fuzzer.coverageTracker.incrementCounter(0), y)) + 1;`;
+        |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 1, 14, 0, 1, 18], []]);
+        |(a === "a" ? (__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, x) : (__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, y)) + 1;`;
+			expectInstrumentation(input, output);
+		});
+	});
+
+	describe("counter pruning", () => {
+		const expectPrunedInstrumentation = instrumentWith(
+			codeCoverage(new ZeroEdgeIdStrategy(), true, true),
+		);
+
+		it("should leave out the counter after an if-else statement", () => {
+			const input = `
+               |if (1 < 2)
+               |  true;
+               |else
+               |  false;`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 2, 3, 0, 4, 3], []]);
+               |if (1 < 2) {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  true;
+               |} else {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  false;
+               |}`;
+			expectPrunedInstrumentation(input, output);
+		});
+
+		it("should leave out counters always hit with the function entry", () => {
+			const input = `
+               |function foo() {
+               |  for (let i = 0; i < 3; i++) {
+               |    bar();
+               |  }
+               |}`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["foo"], [0, 1, 1, 0, 2, 31], [0]]);
+               |function foo() {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  for (let i = 0; i < 3; i++) {
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |    bar();
+               |  }
+               |}`;
+			expectPrunedInstrumentation(input, output);
+		});
+
+		it("should keep the counter after a statement that may return", () => {
+			const input = `
+               |function foo(a) {
+               |  if (a) {
+               |    return 1;
+               |  } else {
+               |    bar();
+               |  }
+               |  baz();
+               |}`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 4, ["test.js", ["foo"], [0, 1, 1, 0, 2, 10, 0, 4, 10, 0, 6, 4], [0]]);
+               |function foo(a) {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  if (a) {
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |    return 1;
+               |  } else {
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |    bar();
+               |  }
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  baz();
+               |}`;
+			expectPrunedInstrumentation(input, output);
+		});
+
+		it("should leave out the counter of an always evaluated operand", () => {
+			const input = `
+               |function foo(a, b) {
+               |  if (a && b) bar();
+               |}`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 3, ["test.js", ["foo"], [0, 1, 1, 0, 2, 15, 0, 2, 12], [0]]);
+               |function foo(a, b) {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  if (a && (__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1, b)) {
+               |    __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |    bar();
+               |  }
+               |}`;
+			expectPrunedInstrumentation(input, output);
+		});
+	});
+
+	describe("module counters", () => {
+		it("should index counters relative to the first edge ID of the module", () => {
+			const instrumentor = new Instrumentor(
+				["*"],
+				[],
+				[],
+				false,
+				false,
+				new MemorySyncIdStrategy(),
+			);
+
+			instrumentor.instrument(
+				"if (1 < 2) { true; } else { false; }",
+				"foo.js",
+			);
+			const code = removeIndentation(
+				instrumentor.instrument("for (;;) { counter++; }", "bar.js")?.code,
+			);
+
+			expect(code).toContain(
+				"const __jazzer_cov = Fuzzer.coverageTracker.counterRange(3, 2);",
+			);
+			expect(code).toContain("__jazzer_cov[0]");
+			expect(code).toContain("__jazzer_cov[1]");
+			expect(code).not.toContain("__jazzer_cov[2]");
+		});
+
+		it("should keep directives in front of the counters", () => {
+			const input = `
+               |"use strict";
+               |if (a) b();`;
+			const output = `
+               |"use strict";
+               |
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2, ["test.js", ["<top-level>"], [0, 2, 8, 0, 2, 12], []]);
+               |if (a) {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  b();
+               |}
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
 			expectInstrumentation(input, output);
 		});
+
+		it("should leave out the source locations unless symbolized", () => {
+			const input = `
+               |if (a) b();`;
+			const output = `
+               |const __jazzer_cov = Fuzzer.coverageTracker.counterRange(0, 2);
+               |if (a) {
+               |  __jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;
+               |  b();
+               |}
+               |__jazzer_cov[0] = __jazzer_cov[0] % 255 + 1;`;
+			instrumentWith(codeCoverage(new ZeroEdgeIdStrategy()))(input, output);
+		});
 	});
 
 	describe("FileSyncIdStrategy", () => {
@@ -225,6 +382,34 @@ describe("code coverage instrumentation", () => {
 					.split(os.EOL)
 					.filter((line) => line !== ""),
 			).toEqual(["foo.js,0,3", "bar.js,3,2", "baz.js,5,4"]);
+
+			fs.rmSync(`${idSyncFile.name}.table`, { force: true });
+		});
+
+		it("should reuse the edge IDs of earlier runs", () => {
+			const idSyncFile = tmp.fileSync({
+				mode: 0o600,
+				prefix: "jazzer.js",
+				postfix: "idSync",
+			});
+			fs.closeSync(idSyncFile.fd);
+			const instrument = (file: string, code: string) =>
+				new Instrumentor(
+					["*"],
+					[],
+					[],
+					false,
+					false,
+					new FileSyncIdStrategy(idSyncFile.name),
+				).instrument(code, file)?.code;
+
+			instrument("foo.js", "if (1 < 2) { true; } else { false; }");
+			const code = "for (let i = 0; i < 100; i++) { counter++; }";
+			const bar = instrument("bar.js", code);
+			expect(bar).toContain("Fuzzer.coverageTracker.counterRange(3, 2");
+			expect(instrument("bar.js", code)).toEqual(bar);
+
+			fs.rmSync(`${idSyncFile.name}.table`, { force: true });
 		});
 	});
 });
@@ -14,19 +14,103 @@
  * limitations under the License.
  */
 
-import { PluginTarget, types } from "@babel/core";
+/**
+ * Coverage plugin for CommonJS modules.
+ *
+ * Edges are counted with inline NeverZero writes to a module-local
+ * Uint8Array, just like in ES modules:
+ *
+ *     __jazzer_cov[id] = (__jazzer_cov[id] % 255) + 1
+ *
+ * Unlike ES modules, the counters are a view into the global coverage map,
+ * as fork mode relies on the global edge IDs being synchronized between
+ * processes (see FileSyncIdStrategy).  The IDs handed out for a module are
+ * consecutive, so the emitted indices are relative to the first one and the
+ * view is bound once at the top of the module:
+ *
+ *     const __jazzer_cov =
+ *       Fuzzer.coverageTracker.counterRange(firstId, count);
+ *
+ * With `symbolizeCounters`, i.e. if libFuzzer output refers to source
+ * locations, the table of the counters' locations (see EdgeSymbols) is
+ * passed along as third argument.  It is as large as the module's
+ * counters, so it's left out otherwise.
+ */
+
+import { NodePath, PluginPass, PluginTarget, types } from "@babel/core";
+import { Program } from "@babel/types";
 
 import { EdgeIdStrategy } from "../edgeIdStrategy";
 
-import { makeCoverageVisitor } from "./coverageVisitor";
+import {
+	COUNTER_ARRAY,
+	makeCoverageVisitor,
+	neverZeroIncrement,
+} from "./coverageVisitor";
+import { EdgeSymbols } from "./edgeSymbols";
+
+export function codeCoverage(
+	idStrategy: EdgeIdStrategy,
+	pruneCounters = false,
+	symbolizeCounters = false,
+): () => PluginTarget {
+	let firstId: number | undefined;
+	let count = 0;
+	const symbols = new EdgeSymbols();
 
-export function codeCoverage(idStrategy: EdgeIdStrategy): () => PluginTarget {
 	return () => ({
-		visitor: makeCoverageVisitor(() =>
-			types.callExpression(
-				types.identifier("Fuzzer.coverageTracker.incrementCounter"),
-				[types.numericLiteral(idStrategy.nextEdgeId())],
+		visitor: {
+			...makeCoverageVisitor(
+				(path, position, functionEntry) => {
+					const id = idStrategy.nextEdgeId();
+					if (firstId === undefined) {
+						firstId = id;
+					}
+					count++;
+					if (symbolizeCounters) {
+						symbols.add(path, position, functionEntry);
+					}
+					return neverZeroIncrement(id - firstId);
+				},
+				pruneCounters,
 			),
-		),
+			Program: {
+				enter() {
+					firstId = undefined;
+					count = 0;
+					symbols.reset();
+				},
+				exit(path: NodePath<Program>, state: PluginPass) {
+					if (firstId === undefined) {
+						return;
+					}
+					// Inserted after directives, so that "use strict" stays in effect.
+					path.unshiftContainer(
+						"body",
+						types.variableDeclaration("const", [
+							types.variableDeclarator(
+								types.identifier(COUNTER_ARRAY),
+								types.callExpression(
+									types.identifier("Fuzzer.coverageTracker.counterRange"),
+									[
+										types.numericLiteral(firstId),
+										types.numericLiteral(count),
+										...(symbolizeCounters
+											? [symbols.toExpression(fileName(state))]
+											: []),
+									],
+								),
+							),
+						]),
+					);
+				},
+			},
+		},
 	});
 }
+
+// The file name as passed to the instrumentor, Babel resolves `filename`
+// against the working directory.
+function fileName(state: PluginPass): string {
+	return state.file.opts.sourceFileName ?? state.filename ?? "";
+}
@@ -174,6 +174,27 @@ describe("compare hooks instrumentation", () => {
 		});
 	});
 
+	describe("BigInt compares", () => {
+		it("intercepts compares with BigInt literals", () => {
+			fuzzer.tracer.traceNumberCmp.mockClear().mockReturnValue(true);
+			(helpers.fakePC as jest.Mock).mockReturnValue(types.numericLiteral(0));
+			const input = `
+			|let a = 10n
+			|a < 0xffffffffffffffffn`;
+			const output = `
+			|let a = 10n;
+			|Fuzzer.tracer.traceNumberCmp(a, 0xffffffffffffffffn, "<", 0);`;
+			const result = expectInstrumentationAndEval<boolean>(input, output);
+			expect(result).toBe(true);
+			expect(fuzzer.tracer.traceNumberCmp).toHaveBeenCalledWith(
+				10n,
+				0xffffffffffffffffn,
+				"<",
+				0,
+			);
+		});
+	});
+
 	describe("switch statements", () => {
 		it("intercepts string cases", () => {
 			const input = `
@@ -229,16 +250,17 @@ describe("compare hooks instrumentation", () => {
 			|    break;				
 			|}`;
 			const output = `
-			|switch (count) {
-            |  case Fuzzer.tracer.traceAndReturn(count, 1, 0):
+			|var _jazzerSwitch = Fuzzer.tracer.switchCases("", 0, [1, 2, 5]);
+			|switch (Fuzzer.tracer.traceSwitch(count, _jazzerSwitch, 0)) {
+            |  case 1:
             |    console.log("1");
             |    break;
             |
-            |  case Fuzzer.tracer.traceAndReturn(count, 2, 0):
+            |  case 2:
             |    console.log("2");
             |    break;
             |
-            |  case Fuzzer.tracer.traceAndReturn(count, 5, 0):
+            |  case 5:
             |    console.log("5");
             |    break;
             |
@@ -248,6 +270,54 @@ describe("compare hooks instrumentation", () => {
             |}`;
 			expectInstrumentation(input, output);
 		});
+
+		it("registers the integer cases of each switch once", () => {
+			fuzzer.tracer.switchCases.mockClear().mockReturnValue(7);
+			fuzzer.tracer.traceSwitch.mockClear().mockImplementation((v) => v);
+			fuzzer.tracer.traceAndReturn
+				.mockClear()
+				.mockImplementation((_, target) => target);
+			const input = `
+			|function kind(value) {
+			|  switch (value) {
+			|    case -1: return "negative";
+			|    case 0x89504e47: return "magic";
+			|    case "a": return "string";
+			|  }
+			|}
+			|function small(value) {
+			|  switch (value + 1) {
+			|    case 2: return "two";
+			|  }
+			|}
+			|[kind(-1), kind(0x89504e47), kind("a"), small(1)]`;
+			const output = `
+			|var _jazzerSwitch2 = Fuzzer.tracer.switchCases("", 1, [2]);
+			|var _jazzerSwitch = Fuzzer.tracer.switchCases("", 0, [-1, 2303741511]);
+			|function kind(value) {
+			|  switch (Fuzzer.tracer.traceSwitch(value, _jazzerSwitch, 0)) {
+			|    case -1:
+			|      return "negative";
+			|    case 0x89504e47:
+			|      return "magic";
+			|    case Fuzzer.tracer.traceAndReturn(value, "a", 0):
+			|      return "string";
+			|  }
+			|}
+			|function small(value) {
+			|  switch (Fuzzer.tracer.traceSwitch(value + 1, _jazzerSwitch2, 0)) {
+			|    case 2:
+			|      return "two";
+			|  }
+			|}
+			|[kind(-1), kind(0x89504e47), kind("a"), small(1)];`;
+			const result = expectInstrumentationAndEval<string[]>(input, output);
+			expect(result).toEqual(["negative", "magic", "string", "two"]);
+			expect(fuzzer.tracer.switchCases).toHaveBeenCalledTimes(2);
+			expect(fuzzer.tracer.switchCases).toHaveBeenCalledWith("", 1, [2]);
+			expect(fuzzer.tracer.traceSwitch).toHaveBeenCalledTimes(4);
+			expect(fuzzer.tracer.traceSwitch).toHaveBeenLastCalledWith(2, 7, 0);
+		});
 	});
 });
 
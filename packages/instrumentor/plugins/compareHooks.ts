@@ -14,13 +14,17 @@
  * limitations under the License.
  */
 
-import { NodePath, PluginTarget, types } from "@babel/core";
+import { NodePath, PluginPass, PluginTarget, types } from "@babel/core";
 import {
 	BinaryExpression,
+	Expression,
+	isBigIntLiteral,
 	isIdentifier,
 	isNumericLiteral,
 	isPrivateName,
 	isStringLiteral,
+	isUnaryExpression,
+	Node,
 	SwitchStatement,
 } from "@babel/types";
 
@@ -53,20 +57,53 @@ export function compareHooks(): PluginTarget {
 					]),
 				);
 			},
-			SwitchStatement(path: NodePath<SwitchStatement>) {
-				if (!isIdentifier(path.node.discriminant)) {
-					return;
-				}
-				const id = path.node.discriminant;
-				for (const i in path.node.cases) {
-					const test = path.node.cases[i].test;
-					if (test) {
-						path.node.cases[i].test = types.callExpression(
+			SwitchStatement(path: NodePath<SwitchStatement>, state: PluginPass) {
+				const discriminant = path.node.discriminant;
+				const integerCases: number[] = [];
+				for (const switchCase of path.node.cases) {
+					const value = integerValue(switchCase.test);
+					if (value !== undefined) {
+						integerCases.push(value);
+					} else if (switchCase.test && isIdentifier(discriminant)) {
+						switchCase.test = types.callExpression(
 							types.identifier("Fuzzer.tracer.traceAndReturn"),
-							[id, test, fakePC()],
+							[discriminant, switchCase.test, fakePC()],
 						);
 					}
 				}
+				if (integerCases.length === 0) {
+					return;
+				}
+
+				// The integer cases are registered once per module, the switch
+				// then only traces its value together with the case table. The
+				// table is keyed by file and site, so that evaluating the module
+				// again reuses it. Lazily compiled functions have file names of
+				// their own.
+				const site: number = state.get("jazzerSwitchSite") ?? 0;
+				state.set("jazzerSwitchSite", site + 1);
+				const program = path.scope.getProgramParent();
+				const table = program.generateUidIdentifier("jazzerSwitch");
+				(program.path as NodePath<types.Program>).unshiftContainer(
+					"body",
+					types.variableDeclaration("var", [
+						types.variableDeclarator(
+							table,
+							types.callExpression(
+								types.identifier("Fuzzer.tracer.switchCases"),
+								[
+									types.stringLiteral(state.filename ?? ""),
+									types.numericLiteral(site),
+									types.arrayExpression(integerCases.map(numberLiteral)),
+								],
+							),
+						),
+					]),
+				);
+				path.node.discriminant = types.callExpression(
+					types.identifier("Fuzzer.tracer.traceSwitch"),
+					[discriminant, table, fakePC()],
+				);
 			},
 		},
 	};
@@ -87,10 +124,10 @@ function isStringCompare(exp: BinaryExpression): boolean {
 }
 
 function isNumberCompare(exp: BinaryExpression): boolean {
-	// One operand has to be a string literal but not both
+	// One operand has to be a number or BigInt literal but not both
 	if (
-		(!isNumericLiteral(exp.left) && !isNumericLiteral(exp.right)) ||
-		(isNumericLiteral(exp.left) && isNumericLiteral(exp.right))
+		(!isNumberLiteral(exp.left) && !isNumberLiteral(exp.right)) ||
+		(isNumberLiteral(exp.left) && isNumberLiteral(exp.right))
 	) {
 		return false;
 	}
@@ -98,3 +135,24 @@ function isNumberCompare(exp: BinaryExpression): boolean {
 		exp.operator,
 	);
 }
+
+function isNumberLiteral(node: Node): boolean {
+	return isNumericLiteral(node) || isBigIntLiteral(node);
+}
+
+// Returns the value of integer literal case tests, including negative ones.
+function integerValue(test: Expression | null | undefined): number | undefined {
+	if (isUnaryExpression(test) && test.operator === "-") {
+		const value = integerValue(test.argument);
+		return value !== undefined ? -value : undefined;
+	}
+	if (isNumericLiteral(test) && Number.isSafeInteger(test.value)) {
+		return test.value;
+	}
+}
+
+function numberLiteral(value: number): Expression {
+	return value < 0
+		? types.unaryExpression("-", types.numericLiteral(-value))
+		: types.numericLiteral(value);
+}
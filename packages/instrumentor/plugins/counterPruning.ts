@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Detection of redundant coverage counters.
+ *
+ * A counter is redundant if it is hit exactly when other counters are
+ * hit, so that it doesn't tell the fuzzer anything new.  Similar to the
+ * pruning of SanitizerCoverage, two cases are detected:
+ *
+ * - The counter is dominated by a counter earlier in the same statement
+ *   list and post-dominates it, i.e. all statements in between complete
+ *   normally.  Statements in a list can only be entered from the previous
+ *   one, so both counters are always hit together.
+ * - The counter after an if-else statement or a switch statement with a
+ *   default case, which can only be reached through one of the counted
+ *   branches, if none of them completes abruptly.
+ *
+ * As in SanitizerCoverage, exceptions thrown by calls, generators that are
+ * not resumed and non-terminating loops are not taken into account.
+ */
+
+import { NodePath } from "@babel/core";
+import {
+	BreakStatement,
+	ContinueStatement,
+	Expression,
+	Node,
+	Statement,
+} from "@babel/types";
+
+export class CounterPruning {
+	// Counter statements emitted by the coverage visitor.
+	private readonly counters = new WeakSet<Node>();
+	private readonly abrupt = new WeakMap<Node, boolean>();
+
+	addCounter(counter: Statement) {
+		this.counters.add(counter);
+	}
+
+	/**
+	 * Whether a counter inserted after the given statement is redundant.
+	 */
+	isRedundantAfter(path: NodePath<Statement>): boolean {
+		if (this.mayCompleteAbruptly(path)) {
+			return false;
+		}
+		if (path.isIfStatement() && path.node.alternate) {
+			return true;
+		}
+		if (
+			path.isSwitchStatement() &&
+			path.node.cases.some((switchCase) => switchCase.test === null)
+		) {
+			return true;
+		}
+		return this.isDominatedByCounter(path);
+	}
+
+	/**
+	 * Whether a counter in front of the given expression is redundant, as
+	 * the expression is always evaluated when its statement is executed.
+	 */
+	isRedundantBefore(path: NodePath<Expression>): boolean {
+		let child: NodePath = path;
+		let parent = path.parentPath;
+		while (parent && !parent.isStatement()) {
+			if (!isUnconditionallyEvaluated(parent, child.key)) {
+				return false;
+			}
+			child = parent;
+			parent = parent.parentPath;
+		}
+		if (!parent || !isEvaluatedFirst(parent, child.key)) {
+			return false;
+		}
+		return this.isDominatedByCounter(parent as NodePath<Statement>);
+	}
+
+	// Whether the statement list containing the given statement has a counter
+	// in front of it that is always followed by the statement.
+	private isDominatedByCounter(path: NodePath<Statement>): boolean {
+		if (!Array.isArray(path.container) || typeof path.key !== "number") {
+			return false;
+		}
+		for (let index = path.key - 1; index >= 0; index--) {
+			const sibling = path.getSibling(index);
+			if (this.counters.has(sibling.node)) {
+				return true;
+			}
+			if (this.mayCompleteAbruptly(sibling)) {
+				return false;
+			}
+		}
+		return false;
+	}
+
+	// Whether the statement may return, throw or jump to a statement outside
+	// of itself. Nested functions and classes are not taken into account.
+	private mayCompleteAbruptly(path: NodePath): boolean {
+		const cached = this.abrupt.get(path.node);
+		if (cached !== undefined) {
+			return cached;
+		}
+
+		let abrupt =
+			path.isReturnStatement() ||
+			path.isThrowStatement() ||
+			path.isBreakStatement() ||
+			path.isContinueStatement();
+		if (!abrupt) {
+			path.traverse({
+				Function(inner) {
+					inner.skip();
+				},
+				Class(inner) {
+					inner.skip();
+				},
+				ReturnStatement(inner) {
+					abrupt = true;
+					inner.stop();
+				},
+				ThrowStatement(inner) {
+					abrupt = true;
+					inner.stop();
+				},
+				BreakStatement(inner) {
+					if (!isJumpWithin(inner, path)) {
+						abrupt = true;
+						inner.stop();
+					}
+				},
+				ContinueStatement(inner) {
+					if (!isJumpWithin(inner, path)) {
+						abrupt = true;
+						inner.stop();
+					}
+				},
+			});
+		}
+		this.abrupt.set(path.node, abrupt);
+		return abrupt;
+	}
+}
+
+// Whether the target of the jump is the given statement or nested in it.
+function isJumpWithin(
+	jump: NodePath<BreakStatement | ContinueStatement>,
+	statement: NodePath,
+): boolean {
+	const label = jump.node.label?.name;
+	const isTarget = (path: NodePath) =>
+		label !== undefined
+			? path.isLabeledStatement() && path.node.label.name === label
+			: path.isLoop() || (jump.isBreakStatement() && path.isSwitchStatement());
+
+	for (let path = jump.parentPath; path; path = path.parentPath) {
+		if (isTarget(path)) {
+			return true;
+		}
+		if (path.node === statement.node) {
+			return false;
+		}
+	}
+	return false;
+}
+
+// Whether the child at the given key is evaluated whenever the expression is.
+function isUnconditionallyEvaluated(
+	parent: NodePath,
+	key: string | number | null,
+): boolean {
+	switch (parent.node.type) {
+		case "LogicalExpression":
+			return key === "left";
+		case "ConditionalExpression":
+			return key === "test";
+		case "AssignmentExpression":
+			return (
+				key === "right" &&
+				!["||=", "&&=", "??="].includes(parent.node.operator)
+			);
+		case "BinaryExpression":
+		case "UnaryExpression":
+		case "SequenceExpression":
+		case "ParenthesizedExpression":
+		case "AwaitExpression":
+		case "CallExpression":
+		case "NewExpression":
+		case "MemberExpression":
+		case "ArrayExpression":
+		case "SpreadElement":
+		case "TemplateLiteral":
+		case "VariableDeclarator":
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Whether the child at the given key is evaluated whenever the statement is
+// executed, before any of its nested statements.
+function isEvaluatedFirst(
+	statement: NodePath,
+	key: string | number | null,
+): boolean {
+	switch (statement.node.type) {
+		case "ExpressionStatement":
+			return key === "expression";
+		case "VariableDeclaration":
+			return true;
+		case "ReturnStatement":
+		case "ThrowStatement":
+			return key === "argument";
+		case "IfStatement":
+			return key === "test";
+		case "SwitchStatement":
+			return key === "discriminant";
+		default:
+			return false;
+	}
+}
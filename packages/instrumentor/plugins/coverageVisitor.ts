@@ -17,8 +17,7 @@
 /**
  * Shared coverage instrumentation visitor.
  *
- * Both the CJS instrumentor (incrementCounter calls) and the ESM
- * instrumentor (direct array writes) inject counters at the same
+ * Both the CJS and the ESM instrumentor inject counters at the same
  * AST locations.  This module captures that shared visitor shape
  * and lets each variant supply its own expression generator.
  */
@@ -28,31 +27,99 @@ import {
 	BlockStatement,
 	ConditionalExpression,
 	Expression,
-	ExpressionStatement,
 	Function,
 	IfStatement,
 	isBlockStatement,
 	isLogicalExpression,
 	LogicalExpression,
 	Loop,
+	SourceLocation,
 	Statement,
 	SwitchStatement,
 	TryStatement,
 } from "@babel/types";
 
+import { CounterPruning } from "./counterPruning";
+
+export const COUNTER_ARRAY = "__jazzer_cov";
+
+/**
+ * Build a NeverZero increment expression:
+ *
+ *     __jazzer_cov[id] = (__jazzer_cov[id] % 255) + 1
+ *
+ * Values cycle 0 → 1 → 2 → … → 255 → 1 → 2 → …, never landing
+ * on zero (which libFuzzer would interpret as "edge not hit").
+ * See https://aflplus.plus//papers/aflpp-woot2020.pdf
+ *
+ * We deliberately avoid `|| 1` because Babel would re-visit the
+ * generated LogicalExpression and trigger infinite recursion in
+ * the coverage visitor.  The `% 255 + 1` form uses only binary
+ * arithmetic, which the visitor does not handle.
+ */
+export function neverZeroIncrement(id: number): Expression {
+	const element = () =>
+		types.memberExpression(
+			types.identifier(COUNTER_ARRAY),
+			types.numericLiteral(id),
+			true, // computed: __jazzer_cov[N]
+		);
+
+	return types.assignmentExpression(
+		"=",
+		element(),
+		types.binaryExpression(
+			"+",
+			types.binaryExpression("%", element(), types.numericLiteral(255)),
+			types.numericLiteral(1),
+		),
+	);
+}
+
+/** Position in the instrumented code that a counter is attributed to. */
+export type EdgePosition = SourceLocation["start"] | undefined;
+
 /**
  * Build a Babel visitor that inserts a counter expression at every
- * branch point.  The caller decides what that expression looks like.
+ * branch point.  The caller decides what that expression looks like
+ * and receives the visited path, the position of the code the counter
+ * belongs to and whether it is the entry counter of a function, e.g.
+ * for symbolization.  With `pruneCounters`, counters that are always
+ * hit together with other counters are left out (see CounterPruning).
  */
 export function makeCoverageVisitor(
-	makeCounterExpr: () => Expression,
+	makeCounterExpr: (
+		path: NodePath,
+		position: EdgePosition,
+		functionEntry: boolean,
+	) => Expression,
+	pruneCounters = false,
 ): Visitor {
-	function makeStmt(): ExpressionStatement {
-		return types.expressionStatement(makeCounterExpr());
+	const pruning = pruneCounters ? new CounterPruning() : undefined;
+
+	function makeStmt(
+		path: NodePath,
+		position: EdgePosition,
+		functionEntry = false,
+	) {
+		const stmt = types.expressionStatement(
+			makeCounterExpr(path, position, functionEntry),
+		);
+		pruning?.addCounter(stmt);
+		return stmt;
+	}
+
+	function insertCounterAfter(
+		path: NodePath<Statement>,
+		position: EdgePosition,
+	) {
+		if (!pruning?.isRedundantAfter(path)) {
+			path.insertAfter(makeStmt(path, position));
+		}
 	}
 
-	function wrapWithCounter(stmt: Statement): BlockStatement {
-		const counter = makeStmt();
+	function wrapWithCounter(path: NodePath, stmt: Statement): BlockStatement {
+		const counter = makeStmt(path, stmt.loc?.start);
 		if (isBlockStatement(stmt)) {
 			stmt.body.unshift(counter);
 			return stmt;
@@ -60,60 +127,62 @@ export function makeCoverageVisitor(
 		return types.blockStatement([counter, stmt]);
 	}
 
+	function withCounter(path: NodePath, expr: Expression) {
+		return types.sequenceExpression([
+			makeCounterExpr(path, expr.loc?.start, false),
+			expr,
+		]);
+	}
+
 	return {
 		Function(path: NodePath<Function>) {
 			if (isBlockStatement(path.node.body)) {
-				path.node.body.body.unshift(makeStmt());
+				path.node.body.body.unshift(
+					makeStmt(path, path.node.loc?.start, true),
+				);
 			}
 		},
 		IfStatement(path: NodePath<IfStatement>) {
-			path.node.consequent = wrapWithCounter(path.node.consequent);
+			path.node.consequent = wrapWithCounter(path, path.node.consequent);
 			if (path.node.alternate) {
-				path.node.alternate = wrapWithCounter(path.node.alternate);
+				path.node.alternate = wrapWithCounter(path, path.node.alternate);
 			}
-			path.insertAfter(makeStmt());
+			insertCounterAfter(path, path.node.loc?.end);
 		},
 		SwitchStatement(path: NodePath<SwitchStatement>) {
 			for (const caseClause of path.node.cases) {
-				caseClause.consequent.unshift(makeStmt());
+				caseClause.consequent.unshift(makeStmt(path, caseClause.loc?.start));
 			}
-			path.insertAfter(makeStmt());
+			insertCounterAfter(path, path.node.loc?.end);
 		},
 		Loop(path: NodePath<Loop>) {
-			path.node.body = wrapWithCounter(path.node.body);
-			path.insertAfter(makeStmt());
+			path.node.body = wrapWithCounter(path, path.node.body);
+			insertCounterAfter(path, path.node.loc?.end);
 		},
 		TryStatement(path: NodePath<TryStatement>) {
 			if (path.node.handler) {
-				path.node.handler.body.body.unshift(makeStmt());
+				path.node.handler.body.body.unshift(
+					makeStmt(path, path.node.handler.loc?.start),
+				);
 			}
-			path.insertAfter(makeStmt());
+			insertCounterAfter(path, path.node.loc?.end);
 		},
 		LogicalExpression(path: NodePath<LogicalExpression>) {
-			if (!isLogicalExpression(path.node.left)) {
-				path.node.left = types.sequenceExpression([
-					makeCounterExpr(),
-					path.node.left,
-				]);
+			if (
+				!isLogicalExpression(path.node.left) &&
+				!pruning?.isRedundantBefore(path)
+			) {
+				path.node.left = withCounter(path, path.node.left);
 			}
 			if (!isLogicalExpression(path.node.right)) {
-				path.node.right = types.sequenceExpression([
-					makeCounterExpr(),
-					path.node.right,
-				]);
+				path.node.right = withCounter(path, path.node.right);
 			}
 		},
 		ConditionalExpression(path: NodePath<ConditionalExpression>) {
-			path.node.consequent = types.sequenceExpression([
-				makeCounterExpr(),
-				path.node.consequent,
-			]);
-			path.node.alternate = types.sequenceExpression([
-				makeCounterExpr(),
-				path.node.alternate,
-			]);
+			path.node.consequent = withCounter(path, path.node.consequent);
+			path.node.alternate = withCounter(path, path.node.alternate);
 			if (isBlockStatement(path.parent)) {
-				path.insertAfter(makeStmt());
+				path.insertAfter(makeStmt(path, path.node.loc?.end));
 			}
 		},
 	};
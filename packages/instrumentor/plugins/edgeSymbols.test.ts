@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import { transformSync } from "@babel/core";
+
+import { esmCodeCoverage } from "./esmCodeCoverage";
+import { removeIndentation } from "./testhelpers";
+
+function symbolsOf(code: string) {
+	const coverage = esmCodeCoverage();
+	transformSync(removeIndentation(code), {
+		filename: "test-module.mjs",
+		plugins: [coverage.plugin],
+	});
+	return {
+		edgeCount: coverage.edgeCount(),
+		table: coverage.symbols("test-module.mjs"),
+	};
+}
+
+describe("edge symbols", () => {
+	it("should record one location per counter", () => {
+		const { edgeCount, table } = symbolsOf(`
+			|function foo(a) {
+			|  if (a) {
+			|    return 1;
+			|  }
+			|}`);
+
+		const [file, functions, locations, entries] = table;
+		expect(file).toBe("test-module.mjs");
+		expect(functions).toEqual(["foo"]);
+		// Function entry, if-consequent, after-if
+		expect(edgeCount).toBe(3);
+		expect(locations).toEqual([0, 1, 1, 0, 2, 10, 0, 4, 4]);
+		expect(entries).toEqual([0]);
+	});
+
+	it("should name anonymous functions and methods", () => {
+		const { table } = symbolsOf(`
+			|class Foo {
+			|  bar() {}
+			|  #baz() {}
+			|}
+			|const qux = () => {};
+			|const obj = { m() {} };
+			|exports.quux = function () {};
+			|[1].map(function () {});
+			|if (x) y();`);
+
+		expect(table[1]).toEqual([
+			"Foo.bar",
+			"Foo.#baz",
+			"qux",
+			"obj.m",
+			"quux",
+			"<anonymous>",
+			"<top-level>",
+		]);
+	});
+});
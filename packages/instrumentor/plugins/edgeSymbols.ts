@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Source locations of the coverage counters of a single module.
+ *
+ * The table is handed to the native addon together with the counters,
+ * so that libFuzzer can symbolize the synthetic PCs of JS counters in
+ * its -print_pcs, -print_funcs and -print_coverage output, and mark
+ * function entries for -focus_function.  It is emitted into the
+ * instrumented code in a compact form:
+ *
+ *     [file, [function names...], [function, line, column, ...], [entries...]]
+ *
+ * with one (function index, line, column) triple per counter and the
+ * indices of the counters at function entries.  Lines and columns are
+ * 1-based, 0 marks an unknown position.
+ */
+
+import { NodePath, types } from "@babel/core";
+import {
+	Expression,
+	Function,
+	isIdentifier,
+	isMemberExpression,
+	isPrivateName,
+	isStringLiteral,
+} from "@babel/types";
+
+import { EdgePosition } from "./coverageVisitor";
+
+export type EdgeSymbolTable = [string, string[], number[], number[]];
+
+// Name used for counters outside any function.
+const TOP_LEVEL = "<top-level>";
+const ANONYMOUS = "<anonymous>";
+
+export class EdgeSymbols {
+	private functions: string[] = [];
+	private functionIndices = new Map<string, number>();
+	private locations: number[] = [];
+	private entries: number[] = [];
+
+	add(path: NodePath, position: EdgePosition, functionEntry: boolean) {
+		const fn = path.isFunction() ? path : path.getFunctionParent();
+		const name = fn ? functionName(fn) : TOP_LEVEL;
+		let index = this.functionIndices.get(name);
+		if (index === undefined) {
+			index = this.functions.length;
+			this.functions.push(name);
+			this.functionIndices.set(name, index);
+		}
+		if (functionEntry) {
+			this.entries.push(this.locations.length / 3);
+		}
+		this.locations.push(
+			index,
+			position?.line ?? 0,
+			position ? position.column + 1 : 0,
+		);
+	}
+
+	reset() {
+		this.functions = [];
+		this.functionIndices.clear();
+		this.locations = [];
+		this.entries = [];
+	}
+
+	table(filename: string): EdgeSymbolTable {
+		return [filename, this.functions, this.locations, this.entries];
+	}
+
+	toExpression(filename: string): Expression {
+		return types.valueToNode(this.table(filename));
+	}
+}
+
+/**
+ * Best-effort name of a function, falling back to the binding it is
+ * assigned to for anonymous functions and qualifying class members
+ * with the class name.
+ */
+function functionName(fn: NodePath<Function>): string {
+	const node = fn.node;
+	if ("id" in node && node.id) {
+		return node.id.name;
+	}
+	if ("key" in node) {
+		const key = node.key;
+		const name = isIdentifier(key)
+			? key.name
+			: isPrivateName(key)
+				? `#${key.id.name}`
+				: isStringLiteral(key)
+					? key.value
+					: ANONYMOUS;
+		const owner = fn.parentPath?.parentPath?.node;
+		if (owner && "id" in owner && isIdentifier(owner.id)) {
+			return `${owner.id.name}.${name}`;
+		}
+		return name;
+	}
+
+	const parent = fn.parent;
+	if (parent.type === "VariableDeclarator" && isIdentifier(parent.id)) {
+		return parent.id.name;
+	}
+	if (
+		(parent.type === "ObjectProperty" || parent.type === "ClassProperty") &&
+		isIdentifier(parent.key)
+	) {
+		return parent.key.name;
+	}
+	if (parent.type === "AssignmentExpression") {
+		if (isIdentifier(parent.left)) {
+			return parent.left.name;
+		}
+		if (isMemberExpression(parent.left) && isIdentifier(parent.left.property)) {
+			return parent.left.property.name;
+		}
+	}
+	return ANONYMOUS;
+}
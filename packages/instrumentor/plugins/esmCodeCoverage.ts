@@ -17,58 +17,26 @@
 /**
  * Coverage plugin for ES modules.
  *
- * Unlike the CJS variant (which calls Fuzzer.coverageTracker.incrementCounter),
- * this plugin emits direct writes to a module-local Uint8Array:
+ * Like the CJS variant, this plugin emits direct writes to a module-local
+ * Uint8Array:
  *
  *     __jazzer_cov[id] = (__jazzer_cov[id] % 255) + 1
  *
  * Each module gets its own small counter buffer, registered independently
  * with libFuzzer.  Edge IDs start at 0 per module -- no global counter
- * coordination is needed.
+ * coordination is needed, whereas CJS modules get a view into the global
+ * coverage map.
  */
 
-import { PluginTarget, types } from "@babel/core";
-import { Expression } from "@babel/types";
+import { PluginTarget } from "@babel/core";
 
-import { makeCoverageVisitor } from "./coverageVisitor";
-
-const COUNTER_ARRAY = "__jazzer_cov";
-
-/**
- * Build a NeverZero increment expression:
- *
- *     __jazzer_cov[id] = (__jazzer_cov[id] % 255) + 1
- *
- * Values cycle 0 → 1 → 2 → … → 255 → 1 → 2 → …, never landing
- * on zero (which libFuzzer would interpret as "edge not hit").
- *
- * We deliberately avoid `|| 1` because Babel would re-visit the
- * generated LogicalExpression and trigger infinite recursion in
- * the coverage visitor.  The `% 255 + 1` form uses only binary
- * arithmetic, which the visitor does not handle.
- */
-function neverZeroIncrement(id: number): Expression {
-	const element = () =>
-		types.memberExpression(
-			types.identifier(COUNTER_ARRAY),
-			types.numericLiteral(id),
-			true, // computed: __jazzer_cov[N]
-		);
-
-	return types.assignmentExpression(
-		"=",
-		element(),
-		types.binaryExpression(
-			"+",
-			types.binaryExpression("%", element(), types.numericLiteral(255)),
-			types.numericLiteral(1),
-		),
-	);
-}
+import { makeCoverageVisitor, neverZeroIncrement } from "./coverageVisitor";
+import { EdgeSymbols, EdgeSymbolTable } from "./edgeSymbols";
 
 export interface EsmCoverageResult {
 	plugin: () => PluginTarget;
 	edgeCount: () => number;
+	symbols: (filename: string) => EdgeSymbolTable;
 }
 
 /**
@@ -76,15 +44,24 @@ export interface EsmCoverageResult {
  *
  * Call this once per module being instrumented.  After the Babel
  * transform finishes, `edgeCount()` returns the number of counters
- * the module needs so the loader can emit the right preamble.
+ * the module needs and `symbols()` their source locations, so the
+ * loader can emit the right preamble.
  */
-export function esmCodeCoverage(): EsmCoverageResult {
+export function esmCodeCoverage(pruneCounters = false): EsmCoverageResult {
 	let count = 0;
+	const symbols = new EdgeSymbols();
 
 	return {
 		plugin: () => ({
-			visitor: makeCoverageVisitor(() => neverZeroIncrement(count++)),
+			visitor: makeCoverageVisitor(
+				(path, position, functionEntry) => {
+					symbols.add(path, position, functionEntry);
+					return neverZeroIncrement(count++);
+				},
+				pruneCounters,
+			),
 		}),
 		edgeCount: () => count,
+		symbols: (filename) => symbols.table(filename),
 	};
 }
@@ -49,7 +49,7 @@ describe("function hooks instrumentation", () => {
 			|foo(1, 2);`;
 			const output = `
 			|function foo(arg1, arg2) {
-			|  HookManager.callHook(0, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(0, this, [arg1, arg2]);
 			|  return arg1 + arg2;
 			|}
 			|
@@ -130,8 +130,8 @@ describe("function hooks instrumentation", () => {
 			|foo(1, 2);`;
 			const output = `
 			|function foo(arg1, arg2) {
-			|  HookManager.callHook(0, this, [arg1, arg2]);
-			|  HookManager.callHook(1, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(0, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(1, this, [arg1, arg2]);
 			|  return arg1 + arg2;
 			|}
 			|
@@ -172,7 +172,7 @@ describe("function hooks instrumentation", () => {
 			|foo(1, 2);`;
 			const output = `
 			|const foo = function (arg1, arg2) {
-			|  HookManager.callHook(0, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(0, this, [arg1, arg2]);
 			|  return arg1 + arg2;
 			|};
 			|
@@ -228,7 +228,7 @@ describe("function hooks instrumentation", () => {
 			|  }
 			|
 			|  foo(x) {
-			|    HookManager.callHook(0, this, [x]);
+			|    HookManager.callBeforeHook(0, this, [x]);
 			|    return this.a + x;
 			|  }
 			|
@@ -296,7 +296,7 @@ describe("function hooks instrumentation", () => {
 			|  }
 			|
 			|  foo(x) {
-			|    HookManager.callHook(0, this, [x]);
+			|    HookManager.callBeforeHook(0, this, [x]);
 			|    return this.a + x;
 			|  }
 			|
@@ -355,7 +355,7 @@ describe("function hooks instrumentation", () => {
 			|};
 			|
 			|A.foo = function (x) {
-			|  HookManager.callHook(0, this, [x]);
+			|  HookManager.callBeforeHook(0, this, [x]);
 			|  return this.a + x;
 			|};
 			|
@@ -401,7 +401,7 @@ describe("function hooks instrumentation", () => {
 			|const obj = {
 			|  a: 1,
 			|  foo: function (x) {
-			|    HookManager.callHook(0, this, [x]);
+			|    HookManager.callBeforeHook(0, this, [x]);
 			|    return this.a + x;
 			|  }
 			|};
@@ -446,7 +446,7 @@ describe("function hooks instrumentation", () => {
 			const output = `
 			|function foo(arg1, arg2) {
 			|  function bar(x) {
-			|    HookManager.callHook(0, this, [x]);
+			|    HookManager.callBeforeHook(0, this, [x]);
 			|    return x + 1;
 			|  }
 			|
@@ -496,7 +496,7 @@ describe("function hooks instrumentation", () => {
 			|  };
 			|
 			|  const foo_original_result = foo_original.call(this, arg1, arg2);
-			|  HookManager.callHook(0, this, [arg1, arg2], foo_original_result);
+			|  HookManager.callAfterHook(0, this, [arg1, arg2], foo_original_result);
 			|  return foo_original_result;
 			|}
 			|
@@ -541,8 +541,8 @@ describe("function hooks instrumentation", () => {
 			|  };
 			|
 			|  const foo_original_result = foo_original.call(this, arg1, arg2);
-			|  HookManager.callHook(0, this, [arg1, arg2], foo_original_result);
-			|  HookManager.callHook(1, this, [arg1, arg2], foo_original_result);
+			|  HookManager.callAfterHook(0, this, [arg1, arg2], foo_original_result);
+			|  HookManager.callAfterHook(1, this, [arg1, arg2], foo_original_result);
 			|  return foo_original_result;
 			|}
 			|
@@ -593,7 +593,7 @@ describe("function hooks instrumentation", () => {
 			|  };
 			|
 			|  return foo_original.call(this, arg1, arg2).then(function (foo_original_result) {
-			|    HookManager.callHook(0, this, [arg1, arg2], foo_original_result);
+			|    HookManager.callAfterHook(0, this, [arg1, arg2], foo_original_result);
 			|    return foo_original_result;
 			|  });
 			|}
@@ -649,10 +649,10 @@ describe("function hooks instrumentation", () => {
 			|  };
 			|
 			|  return foo_original.call(this, arg1, arg2).then(function (foo_original_result) {
-			|    HookManager.callHook(0, this, [arg1, arg2], foo_original_result);
+			|    HookManager.callAfterHook(0, this, [arg1, arg2], foo_original_result);
 			|    return foo_original_result;
 			|  }).then(function (foo_original_result) {
-			|    HookManager.callHook(1, this, [arg1, arg2], foo_original_result);
+			|    HookManager.callAfterHook(1, this, [arg1, arg2], foo_original_result);
 			|    return foo_original_result;
 			|  });
 			|}
@@ -705,7 +705,7 @@ describe("function hooks instrumentation", () => {
 			|    return arg1 + arg2;
 			|  };
 			|
-			|  return HookManager.callHook(0, this, [arg1, arg2], foo_original);
+			|  return HookManager.callReplaceHook(0, this, [arg1, arg2], foo_original);
 			|}
 			|
 			|function bar(arg1) {
@@ -752,7 +752,7 @@ describe("function hooks instrumentation", () => {
 			|      return arg1 + arg2;
 			|    };
 			|
-			|    return HookManager.callHook(0, this, [], a_foo_original);
+			|    return HookManager.callReplaceHook(0, this, [], a_foo_original);
 			|  }
 			|
 			|  return foo();
@@ -802,14 +802,14 @@ describe("function hooks instrumentation", () => {
 			|foo(1, 2)`;
 			const output = `
 			|function foo(arg1, arg2) {
-			|  HookManager.callHook(0, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(0, this, [arg1, arg2]);
 			|
 			|  const foo_original = (arg1, arg2) => {
 			|    return arg1 + arg2;
 			|  };
 			|
 			|  const foo_original_result = foo_original.call(this, arg1, arg2);
-			|  HookManager.callHook(1, this, [arg1, arg2], foo_original_result);
+			|  HookManager.callAfterHook(1, this, [arg1, arg2], foo_original_result);
 			|  return foo_original_result;
 			|}
 			|
@@ -860,7 +860,7 @@ describe("function hooks instrumentation", () => {
 			|foo(1, 2);`;
 			const output = `
 			|function foo(arg1, arg2) {
-			|  HookManager.callHook(0, this, [arg1, arg2]);
+			|  HookManager.callBeforeHook(0, this, [arg1, arg2]);
 			|
 			|  const foo_original = (arg1, arg2) => {
 			|    return new Promise((resolve, reject) => {
@@ -869,7 +869,7 @@ describe("function hooks instrumentation", () => {
 			|  };
 			|
 			|  return foo_original.call(this, arg1, arg2).then(function (foo_original_result) {
-			|    HookManager.callHook(1, this, [arg1, arg2], foo_original_result);
+			|    HookManager.callAfterHook(1, this, [arg1, arg2], foo_original_result);
 			|    return foo_original_result;
 			|  });
 			|}
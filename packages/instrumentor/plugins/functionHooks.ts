@@ -22,6 +22,7 @@ import {
 	Hook,
 	hookManager,
 	hookTracker,
+	HookType,
 	logHooks,
 	MatchingHooksResult,
 } from "@jazzer.js/hooking";
@@ -45,6 +46,13 @@ export function functionHooks(filepath: string): () => PluginTarget {
 
 type FunctionWithBlockBody = babel.Function & { body: babel.BlockStatement };
 
+// Functions of the HookManager calling hooks of the given type.
+const HOOK_CALLS: Record<HookType, string> = {
+	[HookType.Before]: "callBeforeHook",
+	[HookType.Replace]: "callReplaceHook",
+	[HookType.After]: "callAfterHook",
+};
+
 function applyHooks(
 	filepath: string,
 	functionName: string,
@@ -269,7 +277,7 @@ function callHookExpression(
 	return types.callExpression(
 		types.memberExpression(
 			types.identifier("HookManager"),
-			types.identifier("callHook"),
+			types.identifier(HOOK_CALLS[hook.type]),
 		),
 		hookArgs,
 	);
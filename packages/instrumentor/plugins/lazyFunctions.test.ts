@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import { MemorySyncIdStrategy } from "../edgeIdStrategy";
+import { Instrumentor } from "../instrument";
+
+import {
+	LazyFunctionRegistry,
+	lazyFunctions,
+	lazyFunctionsPlugin,
+} from "./lazyFunctions";
+import { instrumentAndEvalWith, instrumentWith } from "./testhelpers";
+
+const globals = globalThis as Record<string, unknown>;
+
+describe("lazy function instrumentation", () => {
+	let registry: LazyFunctionRegistry;
+
+	beforeEach(() => {
+		registry = new LazyFunctionRegistry();
+		globals.LazyFunctions = registry;
+	});
+
+	it("should replace top-level functions by stubs", () => {
+		const input = `
+            |function foo(a, b) {
+            |  return () => a + b;
+            |}`;
+		const output = `
+            |var __jazzer_lazy = [];
+            |function foo(a, b) {
+            |  return (__jazzer_lazy[0] ||= eval(LazyFunctions.compile(0))).apply(this, arguments);
+            |}`;
+		instrumentWith(lazyFunctionsPlugin(registry, "test.js"))(input, output);
+	});
+
+	it("should index the compiled functions per module", () => {
+		const input = `
+            |function foo() {
+            |  return 1;
+            |}`;
+		const output = (id: number) => `
+            |var __jazzer_lazy = [];
+            |function foo() {
+            |  return (__jazzer_lazy[0] ||= eval(LazyFunctions.compile(${id}))).apply(this, arguments);
+            |}`;
+		instrumentWith(lazyFunctionsPlugin(registry, "first.js"))(
+			input,
+			output(0),
+		);
+		instrumentWith(lazyFunctionsPlugin(registry, "second.js"))(
+			input,
+			output(1),
+		);
+	});
+
+	it("should keep functions created more than once", () => {
+		const input = `
+            |for (const a of [1, 2]) {
+            |  setTimeout(function () {
+            |    return a;
+            |  });
+            |}`;
+		instrumentWith(lazyFunctionsPlugin(registry, "test.js"))(input, input);
+	});
+
+	it("should call the original functions through their stubs", () => {
+		const input = `
+            |let calls = 0;
+            |const counter = {
+            |  add(n) {
+            |    calls += n;
+            |    return this;
+            |  }
+            |};
+            |const double = x => x * 2;
+            |counter.add(double(2)).add(1);
+            |calls;`;
+		const output = `
+            |var __jazzer_lazy = [];
+            |let calls = 0;
+            |const counter = {
+            |  add(n) {
+            |    return (__jazzer_lazy[0] ||= eval(LazyFunctions.compile(0))).apply(this, arguments);
+            |  }
+            |};
+            |const double = x => (__jazzer_lazy[1] ||= eval(LazyFunctions.compile(1)))(x);
+            |counter.add(double(2)).add(1);
+            |calls;`;
+		const evalWith = instrumentAndEvalWith(
+			lazyFunctionsPlugin(registry, "test.js"),
+		);
+		expect(evalWith(input, output)).toBe(5);
+	});
+
+	it("should compile a function once and release its source", () => {
+		const sources: string[] = [];
+		registry.setCompiler((fn) => {
+			sources.push(fn.source);
+			return fn.source;
+		});
+		const id = registry.add({
+			filename: "test.js",
+			source: "(function () {})",
+			line: 1,
+			column: 0,
+		});
+		expect(registry.compile(id)).toBe("(function () {})");
+		expect(registry.compile(id)).toBe("(function () {})");
+		expect(sources).toHaveLength(1);
+		expect(JSON.stringify(registry)).not.toContain("test.js");
+	});
+
+	it("should allocate the counters of a function on its first call", () => {
+		const ranges: number[][] = [];
+		globals.Fuzzer = {
+			coverageTracker: {
+				counterRange: (firstId: number, count: number) => {
+					ranges.push([firstId, count]);
+					return new Uint8Array(count);
+				},
+			},
+		};
+		globals.LazyFunctions = lazyFunctions;
+		const instrumentor = new Instrumentor(
+			[],
+			[],
+			[],
+			false,
+			false,
+			new MemorySyncIdStrategy(),
+			undefined,
+			undefined,
+			false,
+			false,
+			true,
+		);
+		const reset = instrumentor.init();
+		try {
+			const code = instrumentor.instrument(
+				`
+				|function sign(a) {
+				|  if (a < 0) {
+				|    return -1;
+				|  }
+				|  return 1;
+				|}
+				|module.exports = sign;`.replace(/^\s*\|/gm, ""),
+				"lazy.js",
+			)?.code;
+			const module = { exports: (a: number) => a };
+			new Function("module", code ?? "")(module);
+			expect(ranges).toHaveLength(0);
+
+			expect(module.exports(-5)).toBe(-1);
+			expect(ranges).toHaveLength(1);
+			expect(module.exports(5)).toBe(1);
+			expect(ranges).toHaveLength(1);
+		} finally {
+			reset();
+			delete globals.Fuzzer;
+		}
+	});
+});
@@ -0,0 +1,324 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Lazy instrumentation of functions.
+ *
+ * Instead of instrumenting the functions of a module up front, their bodies
+ * are replaced by stubs, which instrument and compile the original function
+ * on their first call:
+ *
+ *     function foo(a, b) {
+ *       return (__jazzer_lazy[0] ||= eval(LazyFunctions.compile(7)))
+ *         .apply(this, arguments);
+ *     }
+ *
+ * The array caching the compiled functions is local to the module and indexed
+ * by the number of the stub in it, the ID passed to `compile` is global.
+ *
+ * The direct eval compiles the function in the scope of the stub, so that
+ * it sees the same bindings as the original one.  As a consequence, V8
+ * allocates all variables in scope of the stubs in contexts on the heap,
+ * see the documentation of `lazyInstrumentation`.  Afterwards, the stub only
+ * forwards its calls.  Coverage counters of a function are only allocated
+ * once it is compiled, so that the startup time and the number of counters
+ * depend on the code that is executed and not on the size of the module.
+ *
+ * A compiled function is cached per evaluation of its module and shared by
+ * all instances of the stub, so only functions that are created once per
+ * evaluation are replaced: functions outside of other functions and loops,
+ * also in immediately invoked module wrappers as emitted by bundlers.  The
+ * functions nested in them are instrumented when they are compiled.
+ */
+
+import { NodePath, PluginPass, PluginTarget, types } from "@babel/core";
+import {
+	Expression,
+	Function,
+	isIdentifier,
+	isRestElement,
+	isStringLiteral,
+	Program,
+} from "@babel/types";
+
+import { SourceMap } from "../SourceMapRegistry";
+
+// Module-local cache of the compiled functions.
+const LAZY_ARRAY = "__jazzer_lazy";
+
+// Bindings the stubs rely on, functions in their scope are not replaced.
+const RESERVED = ["eval", "arguments", "LazyFunctions", LAZY_ARRAY];
+
+export interface LazyFunction {
+	filename: string;
+	// The original function as an expression, keeping its name.
+	source: string;
+	line: number;
+	column: number;
+	inputSourceMap?: SourceMap;
+}
+
+export class LazyFunctionRegistry {
+	// Functions to compile, replaced by their code once they are compiled.
+	private functions: (LazyFunction | string)[] = [];
+	private compiler: (fn: LazyFunction) => string = (fn) => fn.source;
+
+	add(fn: LazyFunction): number {
+		this.functions.push(fn);
+		return this.functions.length - 1;
+	}
+
+	setCompiler(compiler: (fn: LazyFunction) => string) {
+		this.compiler = compiler;
+	}
+
+	/**
+	 * Code of the instrumented function with the given ID, evaluated by its
+	 * stub.  Modules evaluated more than once reuse the code of the first
+	 * compilation, and with it, the same coverage counters.  The original
+	 * source and source map of the function are released once it's compiled.
+	 */
+	compile(id: number): string {
+		const fn = this.functions[id];
+		if (typeof fn === "string") {
+			return fn;
+		}
+		const compiled = this.compiler(fn);
+		this.functions[id] = compiled;
+		return compiled;
+	}
+}
+
+export const lazyFunctions = new LazyFunctionRegistry();
+
+export function lazyFunctionsPlugin(
+	registry: LazyFunctionRegistry,
+	filename: string,
+	inputSourceMap?: SourceMap,
+): () => PluginTarget {
+	let enabled = false;
+	let replaced = 0;
+
+	return () => ({
+		visitor: {
+			Program: {
+				enter(path: NodePath<Program>) {
+					// Hoisted functions of ES modules may be called through cyclic
+					// imports before the module body initialized the cache.
+					enabled = !path.node.body.some(
+						(statement) =>
+							types.isImportDeclaration(statement) ||
+							types.isExportDeclaration(statement),
+					);
+					replaced = 0;
+				},
+				exit(path: NodePath<Program>) {
+					if (replaced === 0) {
+						return;
+					}
+					path.unshiftContainer(
+						"body",
+						types.variableDeclaration("var", [
+							types.variableDeclarator(
+								types.identifier(LAZY_ARRAY),
+								types.arrayExpression(),
+							),
+						]),
+					);
+				},
+			},
+			Function(path: NodePath<Function>, state: PluginPass) {
+				if (!enabled || !isReplaceable(path)) {
+					return;
+				}
+				const node = path.node;
+				const id = registry.add({
+					filename,
+					source: functionSource(path, state.file.code),
+					line: node.loc?.start.line ?? 1,
+					column: node.loc?.start.column ?? 0,
+					inputSourceMap,
+				});
+				replaceBody(path, replaced++, id);
+				// Neither the stub nor the original body are instrumented by the
+				// other plugins.
+				path.skip();
+			},
+		},
+	});
+}
+
+function isReplaceable(path: NodePath<Function>): boolean {
+	const node = path.node;
+	if (
+		node.generator ||
+		(path.isClassMethod() && node.kind === "constructor") ||
+		isImmediatelyInvoked(path) ||
+		!isCreatedOnce(path)
+	) {
+		return false;
+	}
+	// Stubs pass on their parameters as they are.
+	const simpleParams = node.params.every(
+		(param) =>
+			isIdentifier(param) ||
+			(isRestElement(param) && isIdentifier(param.argument)),
+	);
+	if (!simpleParams) {
+		return false;
+	}
+	if (RESERVED.some((name) => path.scope.hasBinding(name, true))) {
+		return false;
+	}
+	// Only valid in methods and constructors, not in the compiled function.
+	let usesHomeObject = false;
+	path.traverse({
+		Super(inner) {
+			usesHomeObject = true;
+			inner.stop();
+		},
+		MetaProperty(inner) {
+			usesHomeObject = true;
+			inner.stop();
+		},
+	});
+	return !usesHomeObject;
+}
+
+// Whether the function is created at most once per evaluation of the module.
+function isCreatedOnce(path: NodePath<Function>): boolean {
+	for (let parent = path.parentPath; parent; parent = parent.parentPath) {
+		if (
+			parent.isLoop() ||
+			parent.isClassProperty() ||
+			parent.isClassPrivateProperty() ||
+			parent.isStaticBlock()
+		) {
+			return false;
+		}
+		if (parent.isFunction()) {
+			const id = "id" in parent.node ? parent.node.id : null;
+			// Recursive wrappers are invoked more than once.
+			if (
+				!isImmediatelyInvoked(parent) ||
+				(id && parent.scope.getBinding(id.name)?.referenced)
+			) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Whether the function is called right away, possibly through call or apply.
+function isImmediatelyInvoked(path: NodePath<Function>): boolean {
+	let callee: NodePath = path;
+	let parent = path.parentPath;
+	if (
+		parent?.isMemberExpression({ object: path.node }) &&
+		isIdentifier(parent.node.property) &&
+		["call", "apply"].includes(parent.node.property.name)
+	) {
+		callee = parent;
+		parent = parent.parentPath;
+	}
+	return !!parent?.isCallExpression({ callee: callee.node });
+}
+
+// The original function as an expression.  Function declarations and methods
+// become anonymous function expressions, as their name would be bound in
+// their body, but are named after the stub through the object literal.
+function functionSource(path: NodePath<Function>, code: string): string {
+	const node = path.node;
+	const params = node.params.length
+		? code.slice(
+				node.params[0].start ?? 0,
+				node.params[node.params.length - 1].end ?? 0,
+			)
+		: "";
+	let body = code.slice(node.body.start ?? 0, node.body.end ?? 0);
+	if (!types.isBlockStatement(node.body)) {
+		body = `(${body})`;
+	}
+	const prefix = node.async ? "async " : "";
+	if (path.isFunctionExpression() && node.id) {
+		return `(${prefix}function ${node.id.name}(${params}) ${body})`;
+	}
+	const fn = path.isArrowFunctionExpression()
+		? `${prefix}(${params}) => ${body}`
+		: `${prefix}function (${params}) ${body}`;
+	const name = JSON.stringify(stubName(path));
+	return `({ ${name}: ${fn} })[${name}]`;
+}
+
+function stubName(path: NodePath<Function>): string {
+	const node = path.node;
+	if ("id" in node && node.id) {
+		return node.id.name;
+	}
+	if ("key" in node) {
+		if (isIdentifier(node.key) && !node.computed) {
+			return node.key.name;
+		}
+		return isStringLiteral(node.key) ? node.key.value : "";
+	}
+	const parent = path.parent;
+	if (parent.type === "VariableDeclarator" && isIdentifier(parent.id)) {
+		return parent.id.name;
+	}
+	return "";
+}
+
+function replaceBody(path: NodePath<Function>, index: number, id: number) {
+	const node = path.node;
+	const compiled: Expression = types.assignmentExpression(
+		"||=",
+		types.memberExpression(
+			types.identifier(LAZY_ARRAY),
+			types.numericLiteral(index),
+			true,
+		),
+		types.callExpression(types.identifier("eval"), [
+			types.callExpression(
+				types.memberExpression(
+					types.identifier("LazyFunctions"),
+					types.identifier("compile"),
+				),
+				[types.numericLiteral(id)],
+			),
+		]),
+	);
+	if (path.isArrowFunctionExpression()) {
+		path.node.body = types.callExpression(
+			compiled,
+			path.node.params.map((param) =>
+				isRestElement(param)
+					? types.spreadElement(types.cloneNode(param.argument as Expression))
+					: types.cloneNode(param as Expression),
+			),
+		);
+		path.node.expression = true;
+		return;
+	}
+	node.body = types.blockStatement([
+		types.returnStatement(
+			types.callExpression(
+				types.memberExpression(compiled, types.identifier("apply")),
+				[types.thisExpression(), types.identifier("arguments")],
+			),
+		),
+	]);
+}
@@ -83,7 +83,7 @@ describe("TransformerInterceptor", () => {
 			const { instrumentor, runtime, scriptTransformer } =
 				mockInstrumentorAndRuntime();
 			const originalResult = {
-				code: "some code; Fuzzer.coverageTracker.incrementCounter(); some other code;",
+				code: "some code; Fuzzer.coverageTracker.counterRange(); some other code;",
 				sourceMapPath: "filename",
 				originalCode: "original code",
 			};
@@ -119,7 +119,7 @@ describe("TransformerInterceptor", () => {
 			const { instrumentor, runtime, scriptTransformer } =
 				mockInstrumentorAndRuntime();
 			const originalResult: TransformResult = {
-				code: "some code; Fuzzer.coverageTracker.incrementCounter(); some other code;",
+				code: "some code; Fuzzer.coverageTracker.counterRange(); some other code;",
 				originalCode: "originalCode",
 				sourceMapPath: "sourceMapPath",
 			};
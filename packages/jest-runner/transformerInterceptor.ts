@@ -31,8 +31,12 @@ import { Instrumentor, SourceMap } from "@jazzer.js/instrumentor";
 
 tmp.setGracefulCleanup();
 
-// Code containing coverage instrumentation calls is considered to be instrumented.
-const INSTRUMENTATION_MARKER = "Fuzzer.coverageTracker.incrementCounter";
+// Code binding the coverage counters of a module is considered instrumented.
+const INSTRUMENTATION_MARKERS = [
+	"Fuzzer.coverageTracker.counterRange",
+	// Modules with only lazily instrumented functions have no counters yet.
+	"LazyFunctions.compile",
+];
 
 export function interceptScriptTransformerCalls(
 	runtime: Runtime,
@@ -142,7 +146,7 @@ function intercept(obj: any, name: string, interceptor: Function) {
 }
 
 function isInstrumented(code: string): boolean {
-	return code.includes(INSTRUMENTATION_MARKER);
+	return INSTRUMENTATION_MARKERS.some((marker) => code.includes(marker));
 }
 
 function processTransformResult(
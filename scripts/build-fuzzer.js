@@ -20,10 +20,16 @@ const strip = require("./strip");
 
 fs.mkdirSync("prebuilds", { recursive: true });
 
-// Copy napi release into prebuilds/fuzzer-<platform>-<arch>.node
+// Copy napi release into prebuilds/fuzzer-<platform>-<arch>.node. Builds using
+// V8's C++ API only load into Node versions with the ABI they were built for,
+// which CMake records, and are named fuzzer-<platform>-<arch>-abi<abi>.node.
+const abiFile = path.join("build", "node_abi.txt");
+const abiSuffix = fs.existsSync(abiFile)
+	? `-abi${fs.readFileSync(abiFile, "utf8").trim()}`
+	: "";
 const targetName = path.join(
 	"prebuilds",
-	`fuzzer-${process.platform}-${getArchitecture()}.node`,
+	`fuzzer-${process.platform}-${getArchitecture()}${abiSuffix}.node`,
 );
 fs.copyFileSync("build/Release/jazzerjs.node", targetName);
 
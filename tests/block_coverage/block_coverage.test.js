@@ -0,0 +1,32 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+describe("Block coverage", () => {
+	it.each(["sync", "async"])("guides the fuzzer in %s mode", (mode) => {
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint("fuzz")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(mode === "sync")
+			.runs(1000000)
+			.blockCoverage()
+			.build();
+		expect(() => fuzzTest.execute()).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Found FUZZ");
+	});
+});
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const path = require("path");
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+const bugDetectorDirectory = path.join(__dirname, "buffer-compares");
+
+let fuzzTestBuilder;
+
+beforeEach(() => {
+	fuzzTestBuilder = new FuzzTestBuilder()
+		.runs(500000)
+		.seed(1)
+		.dir(bugDetectorDirectory)
+		.sync(true);
+});
+
+describe("CLI", () => {
+	it("Finds bytes compared with Buffer.equals", () => {
+		const fuzzTest = fuzzTestBuilder.fuzzEntryPoint("equalsSignature").build();
+		expect(() => {
+			fuzzTest.execute();
+		}).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Found the PNG signature");
+	});
+
+	it("Finds bytes compared with Buffer.compare", () => {
+		const fuzzTest = fuzzTestBuilder
+			.fuzzEntryPoint("compareSignature")
+			.build();
+		expect(() => {
+			fuzzTest.execute();
+		}).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Found the PNG signature");
+	});
+
+	it("Finds strings searched with Buffer.indexOf", () => {
+		const fuzzTest = fuzzTestBuilder.fuzzEntryPoint("indexOfString").build();
+		expect(() => {
+			fuzzTest.execute();
+		}).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Found the searched string");
+	});
+
+	it("Does not guide the fuzzer when disabled", () => {
+		const fuzzTest = fuzzTestBuilder
+			.runs(10000)
+			.fuzzEntryPoint("equalsSignature")
+			.disableBugDetectors(["buffer-compares"])
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).not.toContain("Found the PNG signature");
+	});
+});
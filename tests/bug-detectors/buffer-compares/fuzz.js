@@ -0,0 +1,37 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const pngSignature = Buffer.from([
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a,
+]);
+
+module.exports.equalsSignature = function (data) {
+	if (data.length >= 8 && data.subarray(0, 8).equals(pngSignature)) {
+		throw new Error("Found the PNG signature");
+	}
+};
+
+module.exports.compareSignature = function (data) {
+	if (Buffer.compare(data.subarray(0, 8), pngSignature) === 0) {
+		throw new Error("Found the PNG signature");
+	}
+};
+
+module.exports.indexOfString = function (data) {
+	if (data.indexOf("jaz_zer") !== -1) {
+		throw new Error("Found the searched string");
+	}
+};
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const path = require("path");
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+const bugDetectorDirectory = path.join(__dirname, "heap-exhaustion");
+
+let fuzzTestBuilder;
+let nodeOptions;
+
+beforeEach(() => {
+	// A small heap limit keeps the tests fast.
+	nodeOptions = process.env.NODE_OPTIONS;
+	process.env.NODE_OPTIONS = "--max-old-space-size=64";
+	fuzzTestBuilder = new FuzzTestBuilder()
+		.runs(1000000)
+		.dir(bugDetectorDirectory)
+		.sync(true);
+});
+
+afterEach(() => {
+	if (nodeOptions === undefined) {
+		delete process.env.NODE_OPTIONS;
+	} else {
+		process.env.NODE_OPTIONS = nodeOptions;
+	}
+	delete process.env.JAZZER_GC_BUDGET;
+});
+
+// Leaks are only reported once they reach a tenth of the heap limit. With a
+// large limit and a full garbage collection after every 4 MB of heap growth,
+// the live heap is sampled often enough to tell leaks apart from heaps that
+// level off, long before the heap could be exhausted.
+function watchGrowingHeap() {
+	process.env.NODE_OPTIONS = "--max-old-space-size=512";
+	process.env.JAZZER_GC_BUDGET = "4";
+}
+
+describe("CLI", () => {
+	it("Finds a leak across iterations", () => {
+		watchGrowingHeap();
+		const fuzzTest = fuzzTestBuilder.fuzzEntryPoint("leak").build();
+		expect(() => {
+			fuzzTest.execute();
+		}).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Memory Leak");
+		expect(fuzzTest.stderr).not.toContain("Out of Memory");
+		expect(fuzzTest.stderr).toContain("Test unit written to");
+	});
+
+	it("Does not report a heap that levels off", () => {
+		watchGrowingHeap();
+		const fuzzTest = fuzzTestBuilder
+			.runs(200000)
+			.fuzzEntryPoint("plateau")
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).not.toMatch(/Memory Leak|Out of Memory/);
+	});
+
+	it("Finds heap exhaustion within one iteration", () => {
+		const fuzzTest = fuzzTestBuilder.fuzzEntryPoint("exhaust").build();
+		expect(() => {
+			fuzzTest.execute();
+		}).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Out of Memory");
+		expect(fuzzTest.stderr).toContain("Test unit written to");
+	});
+
+	it("Does not watch the heap when disabled", () => {
+		const fuzzTest = fuzzTestBuilder
+			.runs(1000)
+			.fuzzEntryPoint("leak")
+			.disableBugDetectors(["heap-exhaustion"])
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).not.toMatch(/Memory Leak|Out of Memory/);
+	});
+});
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const leaked = [];
+
+module.exports.leak = function (data) {
+	leaked.push(new Array(1000).fill(data.length));
+};
+
+const cached = [];
+
+/**
+ * Caches the arrays of the first 4000 iterations, i.e. about 32 MB, so that the
+ * heap grows at the start and then levels off.
+ * @param { Buffer } data
+ */
+module.exports.plateau = function (data) {
+	const array = new Array(1000).fill(data.length);
+	if (cached.length < 4000) {
+		cached.push(array);
+	}
+};
+
+module.exports.exhaust = function (data) {
+	const objects = [];
+	for (;;) {
+		objects.push({ length: data.length });
+	}
+};
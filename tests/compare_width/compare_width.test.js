@@ -0,0 +1,35 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+describe("Compare width", () => {
+	// Small constants only end up in libFuzzer's table of recent compares if
+	// they are reported as 4-byte compares, guessing both 32-bit values without
+	// it is out of reach of the limited number of runs.
+	it("reports compares with small constants with 4 bytes", () => {
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint("fuzz")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(true)
+			.seed(1234)
+			.runs(100000)
+			.build();
+		expect(() => fuzzTest.execute()).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Found small constants");
+	});
+});
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Both constants fit into 16 bits, libFuzzer only inserts them into the input
+ * if they are reported as 4-byte compares.
+ *
+ * @param { Buffer } data
+ */
+module.exports.fuzz = function (data) {
+	if (data.length < 8) {
+		return;
+	}
+	if (data.readUInt32LE(0) === 0xffd8 && data.readUInt32LE(4) === 0x7f) {
+		throw Error("Found small constants");
+	}
+};
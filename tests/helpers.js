@@ -49,6 +49,10 @@ class FuzzTest {
 		expectedErrors,
 		asJson,
 		timeout,
+		zeroCopyInput,
+		inlineAsync,
+		blockCoverage,
+		fuzzerOptions,
 	) {
 		this.logTestOutput = logTestOutput;
 		this.includes = includes;
@@ -74,6 +78,10 @@ class FuzzTest {
 		this.expectedErrors = expectedErrors;
 		this.asJson = asJson;
 		this.timeout = timeout;
+		this.zeroCopyInput = zeroCopyInput;
+		this.inlineAsync = inlineAsync;
+		this.blockCoverage = blockCoverage;
+		this.fuzzerOptions = fuzzerOptions;
 	}
 
 	// Runs the fuzz test in another process using `spawnSync`.
@@ -102,6 +110,9 @@ class FuzzTest {
 		if (this.sync) options.push("--sync");
 		if (this.coverage) options.push("--coverage");
 		if (this.verbose) options.push("--verbose");
+		if (this.zeroCopyInput) options.push("--zero_copy_input");
+		if (this.inlineAsync) options.push("--inline_async");
+		if (this.blockCoverage) options.push("--block_coverage");
 		if (this.dryRun !== undefined) options.push("--dry_run=" + this.dryRun);
 		if (this.timeout !== undefined) options.push("--timeout=" + this.timeout);
 		for (const include of this.includes) {
@@ -126,6 +137,7 @@ class FuzzTest {
 		for (const dictionary of this.dictionaries) {
 			options.push("-dict=" + dictionary);
 		}
+		options.push(...this.fuzzerOptions);
 		if (useSpawnSync) {
 			this.#spawnTestSync("npx", options, { ...process.env });
 		} else {
@@ -145,6 +157,7 @@ class FuzzTest {
 			(dictionary) => "-dict=" + dictionary,
 		);
 		fuzzerOptions.push(...dictionaries);
+		fuzzerOptions.push(...this.fuzzerOptions);
 
 		const config = {};
 		if (this.sync !== undefined) {
@@ -177,6 +190,15 @@ class FuzzTest {
 		if (this.verbose) {
 			config.verbose = this.verbose;
 		}
+		if (this.zeroCopyInput) {
+			config.zeroCopyInput = this.zeroCopyInput;
+		}
+		if (this.inlineAsync) {
+			config.inlineAsync = this.inlineAsync;
+		}
+		if (this.blockCoverage) {
+			config.blockCoverage = this.blockCoverage;
+		}
 
 		// Write jest config file even if it exists
 		fs.writeFileSync(
@@ -298,6 +320,10 @@ class FuzzTestBuilder {
 	_expectedErrors = [];
 	_asJson = false;
 	_timeout = undefined;
+	_zeroCopyInput = false;
+	_inlineAsync = false;
+	_blockCoverage = false;
+	_fuzzerOptions = [];
 
 	/**
 	 * @param {boolean} logTestOutput - whether to print the output of the fuzz test to the console.
@@ -502,6 +528,38 @@ class FuzzTestBuilder {
 		return this;
 	}
 
+	/**
+	 * @param {boolean} zeroCopyInput - whether to pass the fuzzer input to the fuzz target without copying it.
+	 */
+	zeroCopyInput(zeroCopyInput = true) {
+		this._zeroCopyInput = zeroCopyInput;
+		return this;
+	}
+
+	/**
+	 * @param {boolean} inlineAsync - whether to run async iterations back to back without an event loop turn.
+	 */
+	inlineAsync(inlineAsync = true) {
+		this._inlineAsync = inlineAsync;
+		return this;
+	}
+
+	/**
+	 * @param {boolean} blockCoverage - whether to take the coverage feedback from V8's block coverage.
+	 */
+	blockCoverage(blockCoverage = true) {
+		this._blockCoverage = blockCoverage;
+		return this;
+	}
+
+	/**
+	 * @param {...string} fuzzerOptions - additional libFuzzer options, e.g. "-print_pcs=1".
+	 */
+	fuzzerOptions(...fuzzerOptions) {
+		this._fuzzerOptions = fuzzerOptions;
+		return this;
+	}
+
 	build() {
 		if (this._jestTestFile === "" && this._fuzzEntryPoint === "") {
 			throw new Error("fuzzEntryPoint or jestTestFile are not set.");
@@ -536,6 +594,10 @@ class FuzzTestBuilder {
 			this._expectedErrors,
 			this._asJson,
 			this._timeout,
+			this._zeroCopyInput,
+			this._inlineAsync,
+			this._blockCoverage,
+			this._fuzzerOptions,
 		);
 	}
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+let runs = 0;
+
+/**
+ * Settles in the same microtask checkpoint, so that iterations run inline.
+ * @param { Buffer } data
+ */
+module.exports.resolved_promise = async function (data) {
+	await Promise.resolve(data.length);
+	runs++;
+};
+
+/**
+ * Waits for the event loop in every second iteration.
+ * @param { Buffer } data
+ */
+module.exports.event_loop_promise = async function (data) {
+	if (runs++ % 2 === 0) {
+		await new Promise((resolve) => setImmediate(resolve));
+	}
+};
+
+/**
+ * Calls the done callback directly or from the event loop.
+ * @param { Buffer } data
+ * @param { Function } done
+ */
+module.exports.done_callback = function (data, done) {
+	if (runs++ % 2 === 0) {
+		done();
+	} else {
+		setImmediate(done);
+	}
+};
+
+/**
+ * Reports a finding from an inline iteration.
+ * @param { Buffer } data
+ */
+module.exports.rejected_promise = async function (data) {
+	await Promise.resolve();
+	if (++runs === 500) {
+		throw new Error("Rejected after 500 runs");
+	}
+};
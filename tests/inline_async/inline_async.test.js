@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+describe("Inline async", () => {
+	it.each(["resolved_promise", "event_loop_promise", "done_callback"])(
+		"runs all iterations of %s",
+		(fuzzEntryPoint) => {
+			const fuzzTest = buildFuzzTest(fuzzEntryPoint);
+			fuzzTest.execute();
+			expect(fuzzTest.stderr).toContain("Done 1000 runs");
+		},
+	);
+
+	it("reports findings of inline iterations", () => {
+		const fuzzTest = buildFuzzTest("rejected_promise");
+		expect(() => fuzzTest.execute()).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Rejected after 500 runs");
+	});
+});
+
+function buildFuzzTest(fuzzEntryPoint) {
+	return new FuzzTestBuilder()
+		.fuzzEntryPoint(fuzzEntryPoint)
+		.dir(__dirname)
+		.disableBugDetectors([".*"])
+		.sync(false)
+		.runs(1000)
+		.inlineAsync()
+		.build();
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+describe("Instrumentation workers", () => {
+	let outputDirectory;
+
+	beforeEach(() => {
+		outputDirectory = fs.mkdtempSync(path.join(os.tmpdir(), "jazzer-"));
+	});
+
+	afterEach(() => {
+		delete process.env.JAZZER_INSTRUMENTATION_WORKERS;
+		delete process.env.JAZZER_ID_SYNC_FILE;
+		fs.rmSync(outputDirectory, { recursive: true, force: true });
+	});
+
+	function fuzzTestWithWorkers(workers, runs) {
+		process.env.JAZZER_INSTRUMENTATION_WORKERS = String(workers);
+		return new FuzzTestBuilder()
+			.fuzzEntryPoint("fuzz")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(true)
+			.seed(1234)
+			.runs(runs)
+			.verbose()
+			.fuzzerOptions(`-artifact_prefix=${outputDirectory}${path.sep}`)
+			.build();
+	}
+
+	// The coverage reported by libFuzzer whenever the corpus changed, without
+	// the timing dependent parts.
+	function coverageProgress(fuzzTest) {
+		return Array.from(
+			fuzzTest.stderr.matchAll(/^#(\d+)\s+(\w+)\s+cov: (\d+) ft: (\d+)/gm),
+			(match) => match.slice(1).join(" "),
+		);
+	}
+
+	function crashingInput(fuzzTest) {
+		const match = fuzzTest.stderr.match(/Test unit written to (\S+)/);
+		return match ? path.basename(match[1]) : undefined;
+	}
+
+	it("finds the same crash with the same coverage as without workers", () => {
+		const withoutWorkers = fuzzTestWithWorkers(0, 1000000);
+		expect(() => withoutWorkers.execute()).toThrow(FuzzingExitCode);
+		const withWorkers = fuzzTestWithWorkers(2, 1000000);
+		expect(() => withWorkers.execute()).toThrow(FuzzingExitCode);
+
+		expect(withWorkers.stderr).toContain("in 2 workers");
+		expect(withWorkers.stderr).not.toContain("Instrumentation worker failed");
+		expect(withWorkers.stderr).toContain("Found FUZZ");
+		expect(coverageProgress(withWorkers)).toEqual(
+			coverageProgress(withoutWorkers),
+		);
+		expect(crashingInput(withWorkers)).toBeDefined();
+		expect(crashingInput(withWorkers)).toEqual(crashingInput(withoutWorkers));
+	});
+
+	it("assigns the same edge IDs as without workers", () => {
+		const edgeIds = [0, 2].map((workers) => {
+			const idSyncFile = path.join(outputDirectory, `ids-${workers}`);
+			fs.writeFileSync(idSyncFile, "");
+			process.env.JAZZER_ID_SYNC_FILE = idSyncFile;
+			fuzzTestWithWorkers(workers, 1).execute();
+			return fs.readFileSync(idSyncFile, "utf8");
+		});
+		expect(edgeIds[0]).toContain(path.join("lib", "check.js"));
+		expect(edgeIds[1]).toEqual(edgeIds[0]);
+	});
+});
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Throw for the command "FU" with an argument starting with "ZZ".
+ * @param {{ command: Buffer, argument: Buffer } | undefined} parsed
+ */
+module.exports.check = function (parsed) {
+	if (parsed === undefined) {
+		return;
+	}
+	const { command, argument } = parsed;
+	if (command[0] === "F".charCodeAt(0)) {
+		if (command[1] === "U".charCodeAt(0)) {
+			if (argument[0] === "Z".charCodeAt(0)) {
+				if (argument[1] === "Z".charCodeAt(0)) {
+					throw new Error("Found FUZZ");
+				}
+			}
+		}
+	}
+};
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+let runs = 0;
+
+/**
+ * Takes 20ms in every 500th iteration.
+ * @param { Buffer } data
+ */
+module.exports.fuzz = function (data) {
+	if (++runs % 500 === 0) {
+		const end = Date.now() + 20;
+		while (Date.now() < end) {
+			data.length;
+		}
+	}
+};
+
+/**
+ * Same as `fuzz`, but asynchronous.
+ * @param { Buffer } data
+ */
+module.exports.fuzz_async = async function (data) {
+	module.exports.fuzz(data);
+};
+
+const retained = [];
+
+/**
+ * Keeps the arrays of the last 1000 iterations alive, so that they are
+ * promoted to the old generation before they become garbage.
+ * @param { Buffer } data
+ */
+module.exports.fuzz_allocating = function (data) {
+	retained.push(new Array(1000).fill(data.length));
+	if (retained.length > 1000) {
+		retained.shift();
+	}
+};
+
+/**
+ * Same as `fuzz_allocating`, but asynchronous.
+ * @param { Buffer } data
+ */
+module.exports.fuzz_async_allocating = async function (data) {
+	module.exports.fuzz_allocating(data);
+};
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const { FuzzTestBuilder } = require("../helpers.js");
+
+const environmentVariables = [
+	"JAZZER_SLOW_INPUT_DIRECTORY",
+	"JAZZER_GC_BUDGET",
+];
+
+describe("Profiling", () => {
+	let slowInputDirectory;
+	let previousEnvironment;
+
+	beforeEach(() => {
+		slowInputDirectory = fs.mkdtempSync(path.join(os.tmpdir(), "jazzer-"));
+		previousEnvironment = environmentVariables.map((name) => process.env[name]);
+	});
+
+	afterEach(() => {
+		environmentVariables.forEach((name, i) => {
+			if (previousEnvironment[i] === undefined) {
+				delete process.env[name];
+			} else {
+				process.env[name] = previousEnvironment[i];
+			}
+		});
+		fs.rmSync(slowInputDirectory, { recursive: true, force: true });
+	});
+
+	it.each([
+		["fuzz", true],
+		["fuzz_async", false],
+	])("prints the iteration profile of %s", (fuzzEntryPoint, sync) => {
+		process.env.JAZZER_SLOW_INPUT_DIRECTORY = slowInputDirectory;
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint(fuzzEntryPoint)
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(sync)
+			.runs(3000)
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).toContain("Jazzer.js iteration profile");
+		expect(fuzzTest.stderr).toMatch(/total\s+\d+/);
+		expect(fs.readdirSync(slowInputDirectory).length).toBeGreaterThan(0);
+	});
+
+	it.each([
+		["sync", true],
+		["async", false],
+	])("profiles scheduled garbage collections in %s mode", (_, sync) => {
+		process.env.JAZZER_SLOW_INPUT_DIRECTORY = slowInputDirectory;
+		process.env.JAZZER_GC_BUDGET = "1";
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint(sync ? "fuzz_allocating" : "fuzz_async_allocating")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(sync)
+			.runs(5000)
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).toMatch(/scheduledGc\s+\d+/);
+	});
+
+	// Number of scheduled garbage collections, 0 if there were none.
+	function scheduledGcs(fuzzTest) {
+		const match = fuzzTest.stderr.match(/^scheduledGc\s+(\d+)/m);
+		return match ? Number(match[1]) : 0;
+	}
+
+	it("collects garbage less often with a larger budget", () => {
+		const runs = 20000;
+		process.env.JAZZER_SLOW_INPUT_DIRECTORY = slowInputDirectory;
+		const counts = ["1", "32"].map((budget) => {
+			process.env.JAZZER_GC_BUDGET = budget;
+			const fuzzTest = new FuzzTestBuilder()
+				.fuzzEntryPoint("fuzz_allocating")
+				.dir(__dirname)
+				.disableBugDetectors([".*"])
+				.sync(true)
+				.runs(runs)
+				.build();
+			fuzzTest.execute();
+			return scheduledGcs(fuzzTest);
+		});
+		// The heap is only checked every 16 iterations.
+		expect(counts[0]).toBeGreaterThan(0);
+		expect(counts[0]).toBeLessThanOrEqual(runs / 16);
+		expect(counts[1]).toBeLessThan(counts[0]);
+	});
+});
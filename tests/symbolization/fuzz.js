@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @param { Buffer } data
+ */
+module.exports.fuzz = function fuzz(data) {
+	if (data.length > 2) {
+		return data[0] === data[1];
+	}
+	return false;
+};
+
+/**
+ * @param { Buffer } data
+ */
+module.exports.focus = function focus(data) {
+	if (data.length > 0) {
+		return parse(data.toString());
+	}
+};
+
+function parse(text) {
+	return text.split(",").length;
+}
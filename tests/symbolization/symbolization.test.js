@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+const { FuzzTestBuilder } = require("../helpers.js");
+
+describe("Symbolization", () => {
+	it("prints the source location of new coverage", () => {
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint("fuzz")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(true)
+			.runs(1000)
+			.fuzzerOptions("-print_pcs=1")
+			.build();
+		fuzzTest.execute();
+		// Function entry, branch and the code after it in fuzz.js.
+		expect(fuzzTest.stderr).toMatch(
+			/NEW_PC: 0x[0-9a-f]+ in fuzz \S*fuzz\.js:21:23\n/,
+		);
+		expect(fuzzTest.stderr).toMatch(
+			/NEW_PC: 0x[0-9a-f]+ in fuzz \S*fuzz\.js:22:23\n/,
+		);
+		expect(fuzzTest.stderr).toMatch(
+			/NEW_PC: 0x[0-9a-f]+ in fuzz \S*fuzz\.js:24:3\n/,
+		);
+	});
+
+	it("focuses on a JS function", () => {
+		const fuzzTest = new FuzzTestBuilder()
+			.fuzzEntryPoint("focus")
+			.dir(__dirname)
+			.disableBugDetectors([".*"])
+			.sync(true)
+			.runs(1000)
+			.fuzzerOptions("-focus_function=parse")
+			.build();
+		fuzzTest.execute();
+		expect(fuzzTest.stderr).toContain("INFO: Focus function is set to 'parse'");
+	});
+});
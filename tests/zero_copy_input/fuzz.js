@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+let previousInput;
+
+/**
+ * Inputs of previous iterations must not be accessible anymore.
+ * @param { Buffer } data
+ */
+module.exports.retain_input = function (data) {
+	if (previousInput && previousInput.length !== 0) {
+		throw new Error("Input of previous iteration is still accessible");
+	}
+	previousInput = data;
+};
+
+/**
+ * Same as `retain_input`, but only releases the input once the returned
+ * promise is resolved.
+ * @param { Buffer } data
+ */
+module.exports.retain_input_async = async function (data) {
+	if (previousInput && previousInput.length !== 0) {
+		throw new Error("Input of previous iteration is still accessible");
+	}
+	previousInput = data;
+	const length = data.length;
+	await new Promise((resolve) => setImmediate(resolve));
+	if (data.length !== length) {
+		throw new Error("Input released before the iteration finished");
+	}
+};
+
+/**
+ * @param { Buffer } data
+ */
+module.exports.modify_input = function (data) {
+	if (data.length > 0) {
+		data[0] = ~data[0];
+	}
+};
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 Code Intelligence GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+const { FuzzTestBuilder, FuzzingExitCode } = require("../helpers.js");
+
+describe("Zero-copy input", () => {
+	it.each([true, false])(
+		"releases the input after each run (sync: %s)",
+		(sync) => {
+			buildFuzzTest("retain_input", sync).execute();
+		},
+	);
+
+	it("releases the input once the returned promise is resolved", () => {
+		buildFuzzTest("retain_input_async", false).execute();
+	});
+
+	it.each([true, false])("reports modified inputs (sync: %s)", (sync) => {
+		const fuzzTest = buildFuzzTest("modify_input", sync);
+		expect(() => fuzzTest.execute()).toThrow(FuzzingExitCode);
+		expect(fuzzTest.stderr).toContain("Fuzz target modified its input");
+	});
+});
+
+function buildFuzzTest(fuzzEntryPoint, sync) {
+	return new FuzzTestBuilder()
+		.fuzzEntryPoint(fuzzEntryPoint)
+		.dir(__dirname)
+		.disableBugDetectors([".*"])
+		.sync(sync)
+		.runs(1000)
+		.zeroCopyInput()
+		.build();
+}